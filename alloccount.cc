@@ -0,0 +1,64 @@
+/* 
+
+Copyright (C) 2000 Matthew Danish
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+#include<stdlib.h>
+#include<new>
+using namespace std;
+
+/*
+ * alloccount.cc
+ *
+ * Replaces the global operator new and delete, only to count how
+ * many allocations there are.  It is kept apart from everything
+ * else so the compiler never inlines these into their callers.
+ */
+
+// Every call to operator new, so -b can tell what a birth costs
+long ALLOCATIONS=0;
+
+void *operator new(size_t size) {
+  ALLOCATIONS++;
+  void *p=malloc(size ? size : 1);
+  if(!p) throw bad_alloc();
+  return p;
+}
+
+void *operator new[](size_t size) {
+  return operator new(size);
+}
+
+void operator delete(void *p) {
+  free(p);
+}
+
+void operator delete[](void *p) {
+  free(p);
+}
+
+#if __cplusplus >= 201402L
+// newer compilers hand the size to delete as well
+void operator delete(void *p,size_t) {
+  free(p);
+}
+
+void operator delete[](void *p,size_t) {
+  free(p);
+}
+#endif
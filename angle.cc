@@ -42,9 +42,11 @@ double AngleClass::Angle() {
 }
 
 double AngleClass::Angle(double _angle) {
+  while(_angle>=360) _angle-=360;
+  while(_angle<0) _angle+=360;
   angle=_angle;
-  while(angle>=360) angle-=360;
-  while(angle<0) angle+=360;
+  // a float can round 359.99999 up to 360
+  if(angle>=360) angle=0;
   return angle;
 }
 
@@ -21,11 +21,13 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #ifndef ANGLE_H_756834
 #define ANGLE_H_756834
 
+#include"real.h"
+
 class VectorClass;
 
 class AngleClass {
 private:
-  double angle;
+  real angle;
 public:
   AngleClass();
   AngleClass(double);
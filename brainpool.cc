@@ -0,0 +1,125 @@
+/* 
+
+Copyright (C) 2000 Matthew Danish
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+#include<vector>
+#include<map>
+using namespace std;
+#include"brainpool.h"
+#include"hebbian.h"
+#include"defines.h"
+
+bool BrainPoolClass::Shape::operator <(const Shape &s) const {
+  if(neurodes!=s.neurodes) return neurodes<s.neurodes;
+  if(layers!=s.layers) return layers<s.layers;
+  if(inputs!=s.inputs) return inputs<s.inputs;
+  return outputs<s.outputs;
+}
+
+BrainPoolClass::BrainPoolClass() :
+  stamp(0),
+  count(0),
+  reused(0),
+  made(0)
+{}
+
+BrainPoolClass::~BrainPoolClass() {
+  map<Shape,vector<Spare> >::iterator it;
+  int i;
+  for(it=spare.begin();it!=spare.end();it++) {
+    for(i=0;i<(signed int)it->second.size();i++)
+      delete it->second[i].net;
+  }
+}
+
+// Same arguments as the NeuralNet constructor.  Hands back a spare
+// brain of that shape, rewired with td, or a new one.
+NeuralNet *BrainPoolClass::Get(int n,int n_layers,int ins,int outs,float td) {
+  Shape s;
+  s.neurodes=NeuralNet::Neurodes(n,n_layers);
+  s.layers=n_layers;
+  s.inputs=ins;
+  s.outputs=outs;
+
+  map<Shape,vector<Spare> >::iterator it=spare.find(s);
+  if(it==spare.end() || it->second.empty()) {
+    made++;
+    return new NeuralNet(n,n_layers,ins,outs,td);
+  }
+  // the newest one, it is the likeliest to still be in the cache
+  NeuralNet *net=it->second.back().net;
+  it->second.pop_back();
+  if(it->second.empty()) spare.erase(it);
+  count--;
+  reused++;
+  net->Rewire(td);
+  return net;
+}
+
+// Takes a brain nobody uses any more
+bool BrainPoolClass::Put(NeuralNet *net) {
+  if(!net) return false;
+  if(BRAIN_POOL_SIZE<=0) {
+    delete net;
+    return true;
+  }
+  Shape s;
+  Spare sp;
+  s.neurodes=net->NumNeurodes();
+  s.layers=net->NumLayers();
+  s.inputs=net->NumInputs();
+  s.outputs=net->NumOutputs();
+  sp.stamp=stamp++;
+  sp.net=net;
+  spare[s].push_back(sp);
+  count++;
+  while(count>BRAIN_POOL_SIZE)
+    Evict();
+  return true;
+}
+
+// Deletes the spare brain that has been waiting longest
+bool BrainPoolClass::Evict() {
+  map<Shape,vector<Spare> >::iterator it,oldest=spare.end();
+  for(it=spare.begin();it!=spare.end();it++) {
+    if(!it->second.empty() && (oldest==spare.end() ||
+			       it->second[0].stamp<oldest->second[0].stamp))
+      oldest=it;
+  }
+  if(oldest==spare.end()) return false;
+  delete oldest->second[0].net;
+  oldest->second.erase(oldest->second.begin());
+  if(oldest->second.empty()) spare.erase(oldest);
+  count--;
+  return true;
+}
+
+int BrainPoolClass::Size() {
+  return count;
+}
+
+// How many brains Get() has handed back from the pool
+long BrainPoolClass::Reused() {
+  return reused;
+}
+
+// How many it had to make new
+long BrainPoolClass::Made() {
+  return made;
+}
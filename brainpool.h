@@ -0,0 +1,60 @@
+/* 
+
+Copyright (C) 2000 Matthew Danish
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+#ifndef BRAINPOOL_H_73310
+#define BRAINPOOL_H_73310
+#include<vector>
+#include<map>
+using namespace std;
+
+class NeuralNet;
+
+// Brains of dead organisms, kept for newborns with the same shape
+// so they don't have to be allocated again.  Brains are filed by
+// neurodes, layers, inputs and outputs.  At most BRAIN_POOL_SIZE
+// are kept; past that the one that has been waiting longest is
+// deleted.
+class BrainPoolClass {
+private:
+  struct Shape {
+    int neurodes,layers,inputs,outputs;
+    bool operator <(const Shape &) const;
+  };
+  struct Spare {
+    long stamp;
+    NeuralNet *net;
+  };
+  // oldest first in each list
+  map<Shape,vector<Spare> > spare;
+  long stamp;
+  int count;
+  long reused,made;
+  bool Evict();
+public:
+  BrainPoolClass();
+  ~BrainPoolClass();
+  NeuralNet *Get(int,int,int,int,float);
+  bool Put(NeuralNet *);
+  int Size();
+  long Reused();
+  long Made();
+};
+
+#endif
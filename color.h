@@ -21,9 +21,11 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #ifndef COLOR_H_85679
 #define COLOR_H_85679
 
+#include"real.h"
+
 class ColorClass {
 private:
-  double r,g,b;
+  real r,g,b;
 public:
   ColorClass();
   ColorClass(double,double,double);
@@ -26,6 +26,8 @@
 
 #define ORGANISM_LIVE 0
 #define ORGANISM_FOOD 1
+// Taken out of the world (eaten, decayed, lost), waiting to be deleted
+#define ORGANISM_GONE 2
 
 // Fight threshold: lower values = more fights
 // Original: 10000 (very high, fights rare)
@@ -52,6 +54,32 @@
 #define WORLD_Y 1000
 #define WORLD_Z (FLOOR_BLOCKS_Z-1)*FLOOR_QUAD_SIZE
 
+// Side of a spatial grid cell: the smallest multiple of a floor quad
+// that is at least as long as the longest possible reach
+#define GRID_CELL_SIZE (FLOOR_QUAD_SIZE*((MAX_REACH+FLOOR_QUAD_SIZE-1)/FLOOR_QUAD_SIZE))
+
+// Farthest away (along X or Z) that an organism can touch another
+// one.  Neighbor lists are built this far out plus the skin.
+#define CONTACT_RANGE (MAX_SIDE_LEN+MAX_REACH)
+
+// Most things a k-d tree leaf holds after the tree is built
+#define KDTREE_LEAF_SIZE 8
+
+// How many times -b runs each set of queries, to get past the
+// resolution of clock()
+#define BENCHMARK_REPEAT 10
+
+// How many newborns -b makes at a time to time births
+#define BIRTH_BATCH 100
+
+// Most brains and organisms kept around for reuse once their owner
+// has died, see BrainPoolClass and OrganismClass::operator new
+#define BRAIN_POOL_SIZE 256
+#define ORGANISM_POOL_SIZE 256
+
+// How many ticks apart -m measures how much memory is in use
+#define SOAK_SAMPLE 10000
+
 
 
 struct GeneLimitStruct {
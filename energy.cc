@@ -20,85 +20,58 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 
 #include"energy.h"
 #include"vector.h"
+#include"vitals.h"
 #include"defines.h"
 #include<stdio.h>
 #include<iostream>
 using namespace std;
 
-EnergyClass::EnergyClass() :
-  food(0),
-  health(0),
-  fcap(0),
-  hcap(0)
-{}
-
-EnergyClass::EnergyClass(VectorClass &s) :
-  food(0),
-  health(MIN_ECAP + (s.X() * s.Y() * s.Z() - MIN_VOLUME) * (MAX_ECAP - MIN_ECAP) / (MAX_VOLUME - MIN_VOLUME)),
-  fcap(health),
-  hcap(health)
+extern VitalsClass vitals;
+
+// r is the organism's row, s its size
+EnergyClass::EnergyClass(int r,VectorClass &s) :
+  row(r)
 {
+  vitals.Reset(row,MIN_ECAP + (s.X() * s.Y() * s.Z() - MIN_VOLUME) * (MAX_ECAP - MIN_ECAP) / (MAX_VOLUME - MIN_VOLUME));
 #ifdef _DEBUG
-  printf("HCAP: %f\n",hcap);
+  printf("HCAP: %f\n",vitals.HealthCap(row));
 #endif
 }
 
 EnergyClass::~EnergyClass() {}
 
 double EnergyClass::Food() {
-  return food;
+  return vitals.Food(row);
 }
 
 double EnergyClass::Health() {
-  return health;
+  return vitals.Health(row);
 }
 
 bool EnergyClass::SetCap(VectorClass &s) {
-  hcap = fcap = MIN_ECAP + (s.X() * s.Y() * s.Z() - MIN_VOLUME) * (MAX_ECAP - MIN_ECAP) * (MAX_VOLUME - MIN_VOLUME);
-
-  if(health > hcap) health = hcap;
-  if(food > fcap) food = fcap;
-  return true;
+  return vitals.SetCap(row,MIN_ECAP + (s.X() * s.Y() * s.Z() - MIN_VOLUME) * (MAX_ECAP - MIN_ECAP) * (MAX_VOLUME - MIN_VOLUME));
 }
 
 bool EnergyClass::TakeDamage(double dmg) {
-  health-=dmg;
-  if(health<=0) {
-    health = 0;
-    return false;  // dead!
-  } else
-    return true;
+  return vitals.TakeDamage(row,dmg);
 }
 
 bool EnergyClass::UseEnergy(double amt) {
-  if(food-amt < 0)
-    return false;  // no can do..
-  else {
-    food-=amt;
-    return true;
-  }
+  return vitals.UseEnergy(row,amt);
 }
 
 double EnergyClass::Regen(double meta) {
-  double amt = (hcap-health)/hcap * (fcap-food)/fcap * food * meta;
-  food-=amt;
-  health+=amt;
-  if(health>hcap) health=hcap;
-  if(food<0) food=0;
-  return amt;
+  return vitals.Regen(row,meta);
 }
 
 bool EnergyClass::EatFood(double f) {
-  food+=f;
-  if(f>fcap) f=fcap;
-  if(f<0) f=0;
-  return true;
+  return vitals.EatFood(row,f);
 }
 
 double EnergyClass::HealthCap() {
-  return hcap;
+  return vitals.HealthCap(row);
 }
 
 double EnergyClass::FoodCap() {
-  return fcap;
+  return vitals.FoodCap(row);
 }
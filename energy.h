@@ -25,12 +25,13 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 
 class VectorClass;
 
+// An organism's food and health.  They are kept in its row of the
+// VitalsClass, all this holds is which row that is.
 class EnergyClass {
 private:
-  double food,health,fcap,hcap;
+  int row;
 public:
-  EnergyClass();
-  EnergyClass(VectorClass &);
+  EnergyClass(int,VectorClass &);
   ~EnergyClass();
   double Health();
   double Food();
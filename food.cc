@@ -0,0 +1,95 @@
+/* 
+
+Copyright (C) 2000 Matthew Danish
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+#include<stdlib.h>
+#include<vector>
+using namespace std;
+#include"food.h"
+#include"spatial.h"
+#include"vector.h"
+#include"org.h"
+
+/*
+ * food.cc
+ *
+ * Food never moves, so once it is in the index it stays put until
+ * it is eaten or decays.  Both of those go through Remove(), which
+ * fills the hole with the last piece of food in the store.
+ */
+
+// kind is the kind of SpatialIndexClass to use, min_x,min_z,max_x,
+// max_z are the floor bounds and cs the side of a grid cell
+FoodStoreClass::FoodStoreClass(int kind,double min_x,double min_z,
+			       double max_x,double max_z,double cs) {
+  index=NewSpatialIndex(kind,min_x,min_z,max_x,max_z,cs);
+}
+
+FoodStoreClass::~FoodStoreClass() {
+  int i;
+  for(i=0;i<(signed int)items.size();i++)
+    delete items[i];
+  delete index;
+}
+
+int FoodStoreClass::Size() {
+  return items.size();
+}
+
+OrganismClass *FoodStoreClass::Get(int i) {
+  return items[i];
+}
+
+bool FoodStoreClass::Insert(OrganismClass *o) {
+  index->Insert(o,items.size());
+  items.push_back(o);
+  return true;
+}
+
+// Takes the i'th piece of food out of the store and returns it.
+// The last piece takes its index.
+OrganismClass *FoodStoreClass::Remove(int i) {
+  if(i<0 || i>=(signed int)items.size()) return NULL;
+  OrganismClass *o=items[i];
+  int last=items.size()-1;
+
+  index->Remove(o);
+  if(i!=last) {
+    items[i]=items[last];
+    index->Sequence(items[i],i);
+  }
+  items.pop_back();
+
+  return o;
+}
+
+// Appends at least all the food inside the box centered at p to
+// list.  The caller still has to check the real distances.
+int FoodStoreClass::Query(VectorClass &p,double rx,double rz,
+			  vector<OrganismClass *> &list) {
+  return index->Query(p,rx,rz,list);
+}
+
+// Returns the lowest index of any food inside the box centered at p,
+// or -1 if there isn't any
+int FoodStoreClass::First(VectorClass &p,double rx,double rz) {
+  long seq;
+  if(!index->First(p,rx,rz,NULL,&seq)) return -1;
+  return seq;
+}
@@ -0,0 +1,52 @@
+/* 
+
+Copyright (C) 2000 Matthew Danish
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+#ifndef FOOD_H_29571
+#define FOOD_H_29571
+#include<vector>
+using namespace std;
+
+class OrganismClass;
+class VectorClass;
+class SpatialIndexClass;
+
+// Holds all of the food in the world, apart from the live organisms.
+// Food is kept densely packed, and is found by position through a
+// SpatialIndexClass of whatever kind the organisms use, where each
+// piece's seq is its index in the store.  Removing food swaps the
+// last piece into its place.  The store deletes whatever food is
+// left in it when it is deleted, but food taken out with Remove()
+// is up to the caller.
+class FoodStoreClass {
+private:
+  vector<OrganismClass *> items;
+  SpatialIndexClass *index;
+public:
+  FoodStoreClass(int,double,double,double,double,double);
+  ~FoodStoreClass();
+  int Size();
+  OrganismClass *Get(int);
+  bool Insert(OrganismClass *);
+  OrganismClass *Remove(int);
+  int Query(VectorClass &,double,double,vector<OrganismClass *> &);
+  int First(VectorClass &,double,double);
+};
+
+#endif
@@ -20,7 +20,6 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 
 #include"gene.h"
 #include"vector.h"
-#include<vector>
 #include"braininfo.h"
 #include"defines.h"
 #include<stdio.h>
@@ -30,7 +29,7 @@ using namespace std;
 GeneClass::GeneClass() { // randomly generate one
   int i;
   for(i=0;i<NUM_GENES;i++)
-    DNA.push_back(long(rand()));
+    DNA[i]=rand();
   MakeViable();
 }
 
@@ -38,20 +37,18 @@ GeneClass::GeneClass(GeneClass &a,GeneClass &b) {
   int i;
   for(i=0;i<NUM_GENES;i++) {
     if(double(rand())/RAND_MAX*100.0 <= a.MutationRate())
-      DNA.push_back(SCALE(rand(),0,LONG_MAX,GeneLimits[i].min,GeneLimits[i].max));
+      DNA[i]=SCALE(rand(),0,LONG_MAX,GeneLimits[i].min,GeneLimits[i].max);
     else {
       if((int)((double)(rand())/RAND_MAX*2)) {
-	DNA.push_back(a.DNA[i]);
+	DNA[i]=a.DNA[i];
       } else {
-	DNA.push_back(b.DNA[i]);
+	DNA[i]=b.DNA[i];
       }
 
     }
   }
 }
 
-GeneClass::~GeneClass() {}
-
 double GeneClass::MutationRate() {
   return (double(DNA[GENE_MUTATE_RATE])/MAX_MUTATE_RATE);
 }
@@ -108,8 +105,8 @@ BrainInfoClass GeneClass::Brain() {
 
 bool GeneClass::IsViable() {
   int i;
-  if(MIN_VOLUME > DNA[0]*DNA[1]*DNA[2] || 
-     DNA[0]*DNA[1]*DNA[2] > MAX_VOLUME) return false;
+  if(MIN_VOLUME > long(DNA[0])*DNA[1]*DNA[2] || 
+     long(DNA[0])*DNA[1]*DNA[2] > MAX_VOLUME) return false;
   
   for(i=0;i<NUM_GENES;i++) {
     if(GeneLimits[i].min > DNA[i] || DNA[i] > GeneLimits[i].max)
@@ -156,7 +153,7 @@ bool GeneClass::MakeViable() {
       if(DNA[i] < MIN_SIDE_LEN) DNA[i]=MIN_SIDE_LEN;
       if(DNA[i] > DNA[j]) j = i;
     }
-    tmp = DNA[0] * DNA[1] * DNA[2];
+    tmp = long(DNA[0]) * DNA[1] * DNA[2];
   } while(tmp > MAX_VOLUME && (DNA[j]=long(double(DNA[j])*double(MAX_VOLUME/tmp))));
 
 
@@ -21,20 +21,23 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #ifndef GENE_H_4378354
 #define GENE_H_4378354
 
-#include<vector>
 #include"vector.h"
 #include"braininfo.h"
+#include"defines.h"
 
 using namespace std;
 
+// The genes are held right in the object, so copying a GeneClass is
+// copying one small block and a genome costs no allocation.  No gene
+// is bigger than MAX_LIFESPAN once viable, and a freshly stirred up
+// one is no bigger than RAND_MAX, so an int holds any of them.
 class GeneClass {
 private:
-  vector<long> DNA;
+  int DNA[NUM_GENES];
 
 public:
   GeneClass();
   GeneClass(GeneClass &,GeneClass &);
-  ~GeneClass();
   VectorClass Size();
   BrainInfoClass Brain();
   bool IsViable();
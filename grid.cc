@@ -0,0 +1,200 @@
+/* 
+
+Copyright (C) 2000 Matthew Danish
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+#include<math.h>
+#include<vector>
+using namespace std;
+#include"grid.h"
+#include"vector.h"
+#include"org.h"
+
+/*
+ * grid.cc
+ *
+ * The spatial grid lets an organism look at only the part of
+ * the world around it, instead of walking the whole organism list.
+ * It does best when things are spread out evenly over the floor.
+ */
+
+// min_x,min_z,max_x,max_z are the floor bounds, cs the side of a cell
+SpatialGridClass::SpatialGridClass(double _min_x,double _min_z,
+				   double max_x,double max_z,double cs) :
+  min_x(_min_x),
+  min_z(_min_z),
+  cell_size(cs)
+{
+  cells_x=int(ceil((max_x-min_x)/cell_size));
+  cells_z=int(ceil((max_z-min_z)/cell_size));
+  if(cells_x<1) cells_x=1;
+  if(cells_z<1) cells_z=1;
+  cells.resize(cells_x*cells_z);
+}
+
+SpatialGridClass::~SpatialGridClass() {}
+
+int SpatialGridClass::CellX(double x) {
+  // written this way so that a NaN ends up in the first cell
+  if(!(x>min_x)) return 0;
+  double c=(x-min_x)/cell_size;
+  if(c>=cells_x) return cells_x-1;
+  return int(c);
+}
+
+int SpatialGridClass::CellZ(double z) {
+  if(!(z>min_z)) return 0;
+  double c=(z-min_z)/cell_size;
+  if(c>=cells_z) return cells_z-1;
+  return int(c);
+}
+
+int SpatialGridClass::Cell(VectorClass &p) {
+  return CellZ(p.Z())*cells_x+CellX(p.X());
+}
+
+bool SpatialGridClass::Clear() {
+  int i;
+  for(i=0;i<(signed int)cells.size();i++)
+    cells[i].clear();
+  return true;
+}
+
+bool SpatialGridClass::Insert(OrganismClass *o,long seq) {
+  IndexEntry e;
+  e.o=o;
+  e.seq=seq;
+  cells[Cell(o->Pos())].push_back(e);
+  return true;
+}
+
+bool SpatialGridClass::Remove(OrganismClass *o) {
+  vector<IndexEntry> &c=cells[Cell(o->Pos())];
+  int i;
+  for(i=0;i<(signed int)c.size();i++) {
+    if(c[i].o==o) {
+      c.erase(c.begin()+i);
+      return true;
+    }
+  }
+  return false;
+}
+
+IndexEntry *SpatialGridClass::Find(OrganismClass *o) {
+  vector<IndexEntry> &c=cells[Cell(o->Pos())];
+  int i;
+  for(i=0;i<(signed int)c.size();i++) {
+    if(c[i].o==o) return &c[i];
+  }
+  return NULL;
+}
+
+bool SpatialGridClass::Sequence(OrganismClass *o,long seq) {
+  IndexEntry *e=Find(o);
+  if(!e) return false;
+  e->seq=seq;
+  return true;
+}
+
+bool SpatialGridClass::Move(OrganismClass *o,VectorClass &old) {
+  int from=Cell(old),to=Cell(o->Pos());
+  if(from==to) return true;
+  vector<IndexEntry> &c=cells[from];
+  int i;
+  for(i=0;i<(signed int)c.size();i++) {
+    if(c[i].o==o) {
+      cells[to].push_back(c[i]);
+      c.erase(c.begin()+i);
+      return true;
+    }
+  }
+  return false;
+}
+
+// Does the box reach every cell?
+bool SpatialGridClass::Covers(VectorClass &p,double rx,double rz) {
+  return (CellX(p.X()-rx)==0 && CellX(p.X()+rx)==cells_x-1 &&
+	  CellZ(p.Z()-rz)==0 && CellZ(p.Z()+rz)==cells_z-1);
+}
+
+// Appends everything in the cells touched by the box
+int SpatialGridClass::Query(VectorClass &p,double rx,double rz,
+			    vector<OrganismClass *> &list) {
+  int x0=CellX(p.X()-rx),x1=CellX(p.X()+rx);
+  int z0=CellZ(p.Z()-rz),z1=CellZ(p.Z()+rz);
+  int x,z,i,n=0;
+  for(z=z0;z<=z1;z++) {
+    for(x=x0;x<=x1;x++) {
+      vector<IndexEntry> &c=cells[z*cells_x+x];
+      for(i=0;i<(signed int)c.size();i++)
+	list.push_back(c[i].o);
+      n+=c.size();
+    }
+  }
+  return n;
+}
+
+int SpatialGridClass::QueryEntries(VectorClass &p,double rx,double rz,
+				   vector<IndexEntry> &list) {
+  int x0=CellX(p.X()-rx),x1=CellX(p.X()+rx);
+  int z0=CellZ(p.Z()-rz),z1=CellZ(p.Z()+rz);
+  int x,z,i,n=0;
+  for(z=z0;z<=z1;z++) {
+    for(x=x0;x<=x1;x++) {
+      vector<IndexEntry> &c=cells[z*cells_x+x];
+      for(i=0;i<(signed int)c.size();i++) {
+	if(fabs(c[i].o->Pos().X()-p.X())<=rx &&
+	   fabs(c[i].o->Pos().Z()-p.Z())<=rz) {
+	  list.push_back(c[i]);
+	  n++;
+	}
+      }
+    }
+  }
+  return n;
+}
+
+OrganismClass *SpatialGridClass::First(VectorClass &p,double rx,double rz,
+				       OrganismClass *skip,long *seq) {
+  int x0=CellX(p.X()-rx),x1=CellX(p.X()+rx);
+  int z0=CellZ(p.Z()-rz),z1=CellZ(p.Z()+rz);
+  int x,z,i;
+  IndexEntry *best=NULL;
+  for(z=z0;z<=z1;z++) {
+    for(x=x0;x<=x1;x++) {
+      vector<IndexEntry> &c=cells[z*cells_x+x];
+      for(i=0;i<(signed int)c.size();i++) {
+	if(c[i].o==skip || (best && best->seq<c[i].seq)) continue;
+	if(fabs(c[i].o->Pos().X()-p.X())<=rx &&
+	   fabs(c[i].o->Pos().Z()-p.Z())<=rz)
+	  best=&c[i];
+      }
+    }
+  }
+  if(!best) return NULL;
+  if(seq) *seq=best->seq;
+  return best->o;
+}
+
+double SpatialGridClass::CellSize() {
+  return cell_size;
+}
+
+const char *SpatialGridClass::Name() {
+  return "grid";
+}
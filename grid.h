@@ -0,0 +1,55 @@
+/* 
+
+Copyright (C) 2000 Matthew Danish
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+#ifndef GRID_H_61284
+#define GRID_H_61284
+#include<vector>
+using namespace std;
+#include"spatial.h"
+
+// A uniform grid over the floor, each cell holds the organisms
+// (and food) whose position falls inside of it.  Positions outside
+// of the floor are clamped into the border cells.
+class SpatialGridClass : public SpatialIndexClass {
+private:
+  vector< vector<IndexEntry> > cells;
+  double min_x,min_z,cell_size;
+  int cells_x,cells_z;
+  int CellX(double);
+  int CellZ(double);
+  int Cell(VectorClass &);
+  IndexEntry *Find(OrganismClass *);
+public:
+  SpatialGridClass(double,double,double,double,double);
+  ~SpatialGridClass();
+  bool Clear();
+  bool Insert(OrganismClass *,long);
+  bool Remove(OrganismClass *);
+  bool Move(OrganismClass *,VectorClass &);
+  bool Sequence(OrganismClass *,long);
+  bool Covers(VectorClass &,double,double);
+  int Query(VectorClass &,double,double,vector<OrganismClass *> &);
+  int QueryEntries(VectorClass &,double,double,vector<IndexEntry> &);
+  OrganismClass *First(VectorClass &,double,double,OrganismClass *,long *);
+  double CellSize();
+  const char *Name();
+};
+
+#endif
@@ -29,8 +29,15 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #include<vector>
 #include<math.h>
 #include"hebbian.h"
+#include"nnkernel.h"
 using namespace std;
 
+LayerKernel NeuralNet::kernel=NeurodeKernel(BestNeurodeKernel());
+int NeuralNet::logistic=NN_LOGISTIC_EXACT;
+
+// What BatchFactors() works in, kept from one call to the next
+static vector<float> batch_factors;
+
 
 
 // Constructor for Class NeuralNet
@@ -41,71 +48,165 @@ using namespace std;
 // if it is 1, all inputs will be randomly mapped, if it is 0, no inputs
 // will be randomly mapped.
 
+// Everything is laid out in one block (see Layout()): the neurodes,
+// their outputs, the inputs, room for Learn() to work in, and then
+// layer by layer the weights of all of that layer's neurodes
+// followed by their input indices, each piece starting on a new
+// cache line.
 NeuralNet::NeuralNet(int n,int n_layers,int ins,int outs,float _td) {
-  int remainder=n % n_layers;
-  n+=(n_layers-remainder);
-  inner=new Neurode[n];
-  input=new float[ins];
-  output=new Neurode[outs];
+  n=Neurodes(n,n_layers);
   layers=n_layers;
   num_inner=n;
   num_out=outs;
   num_in=ins;
   num_per_layer=n/n_layers;
-  td=_td;
-  int i,j;
-  for(i=0;i<n;i++) {
-    if(i<num_per_layer) inner[i].num_inputs=num_in;
-    else inner[i].num_inputs=num_per_layer;
-    inner[i].weights=new float[inner[i].num_inputs];
-    inner[i].inputs=new int[inner[i].num_inputs];
+  arena=new char[Layout(NULL)+NN_ALIGN-1];
+  Layout((char *)(((size_t)arena+NN_ALIGN-1) & ~(size_t)(NN_ALIGN-1)));
+  Rewire(_td);
+}
+
+// Rounds n up to a whole cache line
+static size_t Align(size_t n) {
+  return (n+NN_ALIGN-1) & ~(size_t)(NN_ALIGN-1);
+}
+
+// Points everything into the block at base and returns how big the
+// block is.  With base NULL it only works out the size.
+size_t NeuralNet::Layout(char *base) {
+  size_t at=0,w,x;
+  int i,l,per;
+
+  if(base) inner=(Neurode *)(base+at);
+  at+=Align(num_inner*sizeof(Neurode));
+  if(base) output=(Neurode *)(base+at);
+  at+=Align(num_out*sizeof(Neurode));
+  if(base) inner_out=(float *)(base+at);
+  at+=Align(num_inner*sizeof(float));
+  if(base) out=(float *)(base+at);
+  at+=Align(num_out*sizeof(float));
+  if(base) input=(float *)(base+at);
+  at+=Align(num_in*sizeof(float));
+  if(base) factor=(float *)(base+at);
+  at+=Align(num_inner*sizeof(float));
 
+  // the output neurodes are the last layer
+  for(l=0;l<=layers;l++) {
+    Neurode *layer=(l<layers ? inner+l*num_per_layer : output);
+    int count=(l<layers ? num_per_layer : num_out);
+    per=(l==0 ? num_in : num_per_layer);
+    w=at;
+    at+=Align(count*per*sizeof(float));
+    x=at;
+    at+=Align(count*per*sizeof(int));
+    if(!base) continue;
+    for(i=0;i<count;i++) {
+      layer[i].num_inputs=per;
+      layer[i].weights=(float *)(base+w)+i*per;
+      layer[i].inputs=(int *)(base+x)+i*per;
+    }
+  }
+  return at;
+}
+
+// How many inner neurodes a net asked for with n of them in n_layers
+// layers ends up with
+int NeuralNet::Neurodes(int n,int n_layers) {
+  int remainder=n % n_layers;
+  return n+(n_layers-remainder);
+}
+
+// Picks new random weights and input mappings, as if the net had
+// just been made with topological distortion _td.  With a small td
+// most neurodes keep every input where it was, and are dense.
+int NeuralNet::Rewire(float _td) {
+  int i,j;
+  td=_td;
+  num_dense=0;
+  for(i=0;i<num_inner;i++) {
+    inner_out[i]=0;
+    inner[i].dense=1;
     for(j=0;j<inner[i].num_inputs;j++) {
       inner[i].weights[j]=(float)rand()*(2.0/RAND_MAX)-1;
       if((float)rand()*(1.0/RAND_MAX)<=td)
 	inner[i].inputs[j]=int(float(rand())/RAND_MAX*inner[i].num_inputs);
       else
 	inner[i].inputs[j]=j;
+      if(inner[i].inputs[j]!=j) inner[i].dense=0;
     }
+    num_dense+=inner[i].dense;
   }
   for(i=0;i<num_in;i++) 
     input[i]=0;
   for(i=0;i<num_out;i++) {
-    output[i].num_inputs=num_per_layer;
-    output[i].weights=new float[output[i].num_inputs];
-    output[i].inputs=new int[output[i].num_inputs];
-
+    out[i]=0;
+    output[i].dense=1;
     for(j=0;j<output[i].num_inputs;j++) {
       output[i].weights[j]=(float)rand()*(2.0/RAND_MAX)-1;
       if((float)rand()*(1.0/RAND_MAX)<=td)
 	output[i].inputs[j]=int(float(rand())/RAND_MAX*output[i].num_inputs);
       else
 	output[i].inputs[j]=j;
+      if(output[i].inputs[j]!=j) output[i].dense=0;
     }
+    num_dense+=output[i].dense;
   }
+  return 1;
 }
 
 NeuralNet::~NeuralNet() {
-  delete [] inner;
-  delete [] output;
-  delete [] input;
+  delete [] arena;
 }
 
-int NeuralNet::RunNet() {
-  int i,j;
-  float sum;
-  for(i=0;i<num_inner;i++) {
-    inner[i].output=RunNeurode(i);
+// Makes RunNet() use kind (one of the NN_KERNEL_ ones), or returns 0
+// and leaves it alone if this CPU can't run it
+int NeuralNet::UseKernel(int kind) {
+  LayerKernel k=NeurodeKernel(kind);
+  if(!k) return 0;
+  kernel=k;
+  return 1;
+}
+
+// Works out layer l, or the outputs when l is layers.  The first
+// layer reads the inputs, every inner neurode after that the
+// num_per_layer neurodes right before it, and the outputs read the
+// first layer.  Each run of dense neurodes, or of ones that aren't,
+// goes to the kernel in one call, the dense ones without indices.
+int NeuralNet::RunLayer(int l) {
+  Neurode *n;
+  const float *src;
+  float *dst;
+  int i,j,count,per,src_step;
+
+  if(l==layers) {
+    n=output;
+    count=num_out;
+    per=num_per_layer;
+    src=inner_out;
+    src_step=0;
+    dst=out;
+  } else {
+    n=inner+l*num_per_layer;
+    count=num_per_layer;
+    per=(l==0 ? num_in : num_per_layer);
+    src=(l==0 ? input : inner_out+(l-1)*num_per_layer);
+    src_step=(l==0 ? 0 : 1);
+    dst=inner_out+l*num_per_layer;
   }
-  for(i=0;i<num_out;i++) {
-    sum=0;
-    for(j=0;j<num_per_layer;j++) 
-      sum+=output[i].weights[j]*inner[output[i].inputs[j]].output;
-    output[i].output=sum;
+  for(i=0;i<count;i=j) {
+    for(j=i+1;j<count && n[j].dense==n[i].dense;j++) ;
+    kernel(n[i].weights,(n[i].dense ? NULL : n[i].inputs),per,j-i,
+	   src+i*src_step,src_step,dst+i);
   }
   return 1;
 }
 
+int NeuralNet::RunNet() {
+  int l;
+  for(l=0;l<=layers;l++)
+    RunLayer(l);
+  return 1;
+}
+
 float NeuralNet::RunNeurode(int n) {
   float sum=0;
   int i;
@@ -115,25 +216,146 @@ float NeuralNet::RunNeurode(int n) {
       sum+=input[inner[n].inputs[i]]*inner[n].weights[i];
   } else {
     for(i=0;i<inner[n].num_inputs;i++)
-      sum+=inner[n-num_per_layer+inner[n].inputs[i]].output*inner[n].weights[i];
+      sum+=inner_out[n-num_per_layer+inner[n].inputs[i]]*inner[n].weights[i];
   }
   return sum;
 }
 #define E 2.7182818285
 
+// Makes Learn() use kind (NN_LOGISTIC_EXACT or NN_LOGISTIC_FAST)
+int NeuralNet::UseLogistic(int kind) {
+  if(kind!=NN_LOGISTIC_EXACT && kind!=NN_LOGISTIC_FAST) return 0;
+  logistic=kind;
+  return 1;
+}
+
 // lc is the Hebbian learning constant
 // alpha is a logistic coefficient.  seems to work best when <0
+// How far a neurode's weights move depends on the neurode's output
+// through the logistic, which is the same for all of its weights, so
+// it is worked out once per neurode.  The fast way does all of them
+// at once first, see LogisticFactors().
 
 int NeuralNet::Learn(float lc,float alpha) {
+  int l;
+  Factors(0,num_inner,lc,alpha);
+  for(l=0;l<layers;l++)
+    LearnLayer(l,lc,alpha);
+  return 1;
+}
+
+// Learning only moves the weights, and a layer's outputs only depend
+// on its own weights and what came before it, so each layer can
+// learn as soon as it has been worked out, while its weights, input
+// indices and inputs are still in the cache.  Comes out the same as
+// RunNet() and then Learn().
+int NeuralNet::RunAndLearn(float lc,float alpha) {
+  int l;
+  for(l=0;l<layers;l++) {
+    RunLayer(l);
+    Factors(l*num_per_layer,num_per_layer,lc,alpha);
+    LearnLayer(l,lc,alpha);
+  }
+  RunLayer(layers);
+  return 1;
+}
+
+// Thinks, and learns with lc[k] for nets[k], for count nets that all
+// have the same shape (see BrainPoolClass).  Each weight still has
+// its own net, so instead of one big matrix product this goes a
+// layer at a time across a block of nets, small enough that the
+// block's layer is still in the cache when it learns, and works out
+// the whole block's logistic factors for a layer in one go.  With
+// fused 0 it learns afterwards, like RunNet() and then Learn().
+// Comes out the same as doing one net at a time.
+int NeuralNet::RunBatch(NeuralNet **nets,int count,const float *lc,
+			float alpha,int fused) {
+  NeuralNet *nn=nets[0];
+  size_t widest=nn->num_per_layer*(size_t)nn->num_in;
+  int b,k,l,block,end;
+
+  if(nn->num_per_layer*(size_t)nn->num_per_layer>widest)
+    widest=nn->num_per_layer*(size_t)nn->num_per_layer;
+  if(nn->num_out*(size_t)nn->num_per_layer>widest)
+    widest=nn->num_out*(size_t)nn->num_per_layer;
+  widest*=sizeof(float)+sizeof(int);
+  block=(widest<NN_BATCH_BYTES ? NN_BATCH_BYTES/widest : 1);
+
+  for(b=0;b<count;b+=block) {
+    end=(b+block<count ? b+block : count);
+    for(l=0;l<nn->layers;l++) {
+      for(k=b;k<end;k++)
+	nets[k]->RunLayer(l);
+      if(!fused) continue;
+      BatchFactors(nets+b,end-b,l,lc+b,alpha);
+      for(k=b;k<end;k++)
+	nets[k]->LearnLayer(l,lc[k],alpha);
+    }
+    for(k=b;k<end;k++)
+      nets[k]->RunLayer(nn->layers);
+    if(fused) continue;
+    for(k=b;k<end;k++)
+      nets[k]->Learn(lc[k],alpha);
+  }
+  return 1;
+}
+
+// Factors() for layer l of count nets of the same shape at once.
+// They are worked out with a scale of 1 and then multiplied by each
+// net's lc, which rounds the same as scaling by lc to begin with
+// since the 1/2 in the scale is exact.
+int NeuralNet::BatchFactors(NeuralNet **nets,int count,int l,
+			    const float *lc,float alpha) {
+  int per=nets[0]->num_per_layer,first=l*per;
+  int i,k;
+  float *x;
+
+  if(logistic!=NN_LOGISTIC_FAST) return 0;
+  batch_factors.resize(count*per);
+  x=&batch_factors[0];
+  for(k=0;k<count;k++) {
+    for(i=0;i<per;i++)
+      x[k*per+i]=nets[k]->inner_out[first+i];
+  }
+  LogisticFactors(x,count*per,alpha,1);
+  for(k=0;k<count;k++) {
+    for(i=0;i<per;i++)
+      nets[k]->factor[first+i]=x[k*per+i]*lc[k];
+  }
+  return 1;
+}
+
+// With the fast logistic, works out the factors of count inner
+// neurodes from first on, as many at once as there are
+int NeuralNet::Factors(int first,int count,float lc,float alpha) {
+  int i;
+  if(logistic!=NN_LOGISTIC_FAST) return 0;
+  for(i=first;i<first+count;i++)
+    factor[i]=inner_out[i];
+  LogisticFactors(factor+first,count,alpha,lc);
+  return 1;
+}
+
+// Learn() for inner layer l, once Factors() has been through it
+int NeuralNet::LearnLayer(int l,float lc,float alpha) {
+  Neurode *n=inner+l*num_per_layer;
+  float *fs=factor+l*num_per_layer,*os=inner_out+l*num_per_layer;
+  const float *src;
+  double f;
   int i,j;
-  for(i=0;i<num_inner;i++) {
-    if(i<num_per_layer) {
-      for(j=0;j<inner[i].num_inputs;j++)
-	inner[i].weights[j]+=lc*(1/(1+pow(E,-alpha*inner[i].output))-0.5)*(input[inner[i].inputs[j]]-0.5); // Yaeger's model
+
+  for(i=0;i<num_per_layer;i++) {
+    src=(l==0 ? input : os-num_per_layer+i);
+    if(logistic==NN_LOGISTIC_FAST)
+      f=fs[i];
+    else
+      f=lc*(1/(1+pow(E,-alpha*os[i]))-0.5);
+    if(n[i].dense) {
+      for(j=0;j<n[i].num_inputs;j++)
+	n[i].weights[j]+=f*(src[j]-0.5); // Yaeger's model
     } else {
-      for(j=0;j<inner[i].num_inputs;j++)
-	inner[i].weights[j]+=lc*(1/(1+pow(E,-alpha*inner[i].output))-0.5)*(inner[i-num_per_layer+inner[i].inputs[j]].output-0.5); // Yaeger's model
-      
+      for(j=0;j<n[i].num_inputs;j++)
+	n[i].weights[j]+=f*(src[n[i].inputs[j]]-0.5);
     }
   }
   return 1;
@@ -143,6 +365,14 @@ int NeuralNet::NumInputs() {
   return num_in;
 }
 
+int NeuralNet::NumNeurodes() {
+  return num_inner;
+}
+
+int NeuralNet::NumLayers() {
+  return layers;
+}
+
 int NeuralNet::SetInputs(vector<float> &list) {
   if((signed int)list.size()!=num_in) return 0;
   for(int i=0;i<num_in;i++) 
@@ -150,15 +380,27 @@ int NeuralNet::SetInputs(vector<float> &list) {
   return 1;
 }
 
+// Copies NumInputs() floats from list
+int NeuralNet::SetInputs(const float *list) {
+  for(int i=0;i<num_in;i++) 
+    input[i]=list[i];
+  return 1;
+}
+
 int NeuralNet::NumOutputs() {
   return num_out;
 }
 
 int NeuralNet::GetOutputs(vector<float> &list) {
   for(int i=0;i<num_out;i++)
-    list.push_back(output[i].output);
+    list.push_back(out[i]);
   return 1;
 }
+
+// How many of the inner and output neurodes are dense
+int NeuralNet::NumDense() {
+  return num_dense;
+}
 /*
 NeuralNetStruct *NeuralNet::NewNeuralNetStruct() {
   NeuralNetStruct *nn=new NeuralNetStruct;
@@ -21,33 +21,71 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #ifndef HEBBIAN_H_678945
 #define HEBBIAN_H_678945
 
+#include<stddef.h>
 #include<vector>
 using namespace std;
+#include"nnkernel.h"
 
 struct NeuralNetStruct;
 
+// dense when inputs[j] is j for every j, so RunNet() and Learn()
+// can read the inputs straight along instead of through inputs
 struct Neurode {
   float *weights;
   int *inputs;
   int num_inputs;
-  float output;
+  int dense;
 };
 
+// Neurodes, inputs, weights and input indices all sit in arena
+#define NN_ALIGN 64
+
+// RunBatch() goes through nets in blocks of about this many bytes of
+// their widest layer's weights and input indices
+#define NN_BATCH_BYTES 16384
+
+// pow() every time, or LogisticFactors()
+#define NN_LOGISTIC_EXACT 0
+#define NN_LOGISTIC_FAST 1
+
 class NeuralNet {
 private:
+  char *arena;
   Neurode *inner,*output;
-  float *input,td;
+  // what the inner and output neurodes put out, one after the other
+  float *inner_out,*out;
+  float *input,*factor,td;
   int layers,num_inner,num_out,num_in,num_per_layer;
+  int num_dense;
+  size_t Layout(char *);
+  int RunLayer(int);
+  int Factors(int,int,float,float);
+  int LearnLayer(int,float,float);
+  static int BatchFactors(NeuralNet **,int,int,const float *,float);
+  // what RunNet() works the layers out with, see nnkernel.h
+  static LayerKernel kernel;
+  // how Learn() works out the logistic
+  static int logistic;
 public:
   NeuralNet(int,int,int,int,float);
   ~NeuralNet();
+  static int Neurodes(int,int);
+  static int UseKernel(int);
+  static int UseLogistic(int);
+  int Rewire(float);
   int RunNet();
   float RunNeurode(int);
   int NumInputs();
+  int NumNeurodes();
+  int NumLayers();
   int SetInputs(vector<float> &);
+  int SetInputs(const float *);
   int NumOutputs();
+  int NumDense();
   int GetOutputs(vector<float> &);
   int Learn(float,float);
+  int RunAndLearn(float,float);
+  static int RunBatch(NeuralNet **,int,const float *,float,int);
   NeuralNetStruct *NewNeuralNetStruct();
 };
 
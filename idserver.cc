@@ -32,19 +32,19 @@ IdServerClass::~IdServerClass()
 {}
 
 
-IdToken *IdServerClass::GetToken() {
-  IdToken *token=new IdToken;
+IdToken IdServerClass::GetToken() {
+  IdToken token;
 
-  token->timestamp=time(NULL);
-  token->mod=0;
+  token.timestamp=time(NULL);
+  token.mod=0;
 
-  if(token->timestamp == last_timestamp)
-    token->mod = last_mod+1;
+  if(token.timestamp == last_timestamp)
+    token.mod = last_mod+1;
   else
     last_mod = 0;
 
-  last_timestamp = token->timestamp;
-  last_mod = token->mod;
+  last_timestamp = token.timestamp;
+  last_mod = token.mod;
 
   return token;
 }
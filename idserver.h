@@ -22,7 +22,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #ifndef IDSERVER_H_34845
 #define IDSERVER_H_34845
 
-struct IdToken;
+#include"id.h"
 
 class IdServerClass {
 private:
@@ -31,7 +31,7 @@ private:
 public:
   IdServerClass();
   ~IdServerClass();
-  IdToken *GetToken();
+  IdToken GetToken();
 };
 
 #endif
@@ -0,0 +1,325 @@
+/* 
+
+Copyright (C) 2000 Matthew Danish
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+#include<math.h>
+#include<vector>
+#include<algorithm>
+using namespace std;
+#include"kdtree.h"
+#include"vector.h"
+#include"org.h"
+#include"defines.h"
+
+/*
+ * kdtree.cc
+ *
+ * The k-d tree adapts to how things are spread around, which helps
+ * when organisms are crowded around a few patches of food.
+ */
+
+// NaNs are kept at the low end of everything
+static double Key(double x) {
+  return (x==x ? x : -HUGE_VAL);
+}
+
+static bool CloserX(const IndexEntry &a,const IndexEntry &b) {
+  return Key(a.o->Pos().X())<Key(b.o->Pos().X());
+}
+
+static bool CloserZ(const IndexEntry &a,const IndexEntry &b) {
+  return Key(a.o->Pos().Z())<Key(b.o->Pos().Z());
+}
+
+// cs is only used as the size to start searches at
+KdTreeClass::KdTreeClass(double cs) :
+  count(0),
+  changes(0),
+  cell_size(cs)
+{}
+
+KdTreeClass::~KdTreeClass() {}
+
+bool KdTreeClass::Clear() {
+  nodes.clear();
+  leaf_of.clear();
+  count=changes=0;
+  return true;
+}
+
+// Makes a node out of all[lo..hi-1] under parent, returns its index
+int KdTreeClass::Build(int lo,int hi,int parent) {
+  int n=nodes.size(),i,mid;
+  nodes.push_back(KdNode());
+  KdNode &k=nodes[n];
+  k.parent=parent;
+  k.left=k.right=-1;
+  k.axis=0;
+  k.split=0;
+  k.min_x=k.min_z=HUGE_VAL;
+  k.max_x=k.max_z=-HUGE_VAL;
+  for(i=lo;i<hi;i++) {
+    double x=Key(all[i].o->Pos().X()),z=Key(all[i].o->Pos().Z());
+    if(x<k.min_x) k.min_x=x;
+    if(x>k.max_x) k.max_x=x;
+    if(z<k.min_z) k.min_z=z;
+    if(z>k.max_z) k.max_z=z;
+  }
+
+  if(hi-lo<=KDTREE_LEAF_SIZE) {
+    for(i=lo;i<hi;i++) {
+      k.items.push_back(all[i]);
+      Leaf(all[i].o,n);
+    }
+    return n;
+  }
+
+  int axis=(k.max_x-k.min_x >= k.max_z-k.min_z ? 0 : 1);
+  mid=(lo+hi)/2;
+  nth_element(all.begin()+lo,all.begin()+mid,all.begin()+hi,
+	      (axis ? CloserZ : CloserX));
+  double split=(axis ? Key(all[mid].o->Pos().Z()) : Key(all[mid].o->Pos().X()));
+
+  // k may move when nodes grows, so it is not used past here
+  int left=Build(lo,mid,n);
+  int right=Build(mid,hi,n);
+  nodes[n].axis=axis;
+  nodes[n].split=split;
+  nodes[n].left=left;
+  nodes[n].right=right;
+  return n;
+}
+
+bool KdTreeClass::Rebuild() {
+  int i;
+  all.clear();
+  for(i=0;i<(signed int)nodes.size();i++) {
+    if(nodes[i].left<0)
+      all.insert(all.end(),nodes[i].items.begin(),nodes[i].items.end());
+  }
+  nodes.clear();
+  changes=0;
+  if(!all.empty()) Build(0,all.size(),-1);
+  return true;
+}
+
+// Rebuilds the tree if it has gone stale, before it is searched
+bool KdTreeClass::Check() {
+  if(changes>count && changes>KDTREE_LEAF_SIZE) Rebuild();
+  return true;
+}
+
+// Widens node n and everything above it to take in p, returns
+// false if p was inside n already
+bool KdTreeClass::Grow(int n,VectorClass &p) {
+  double x=Key(p.X()),z=Key(p.Z());
+  KdNode &leaf=nodes[n];
+  if(x>=leaf.min_x && x<=leaf.max_x && z>=leaf.min_z && z<=leaf.max_z)
+    return false;
+  while(n>=0) {
+    KdNode &k=nodes[n];
+    if(x<k.min_x) k.min_x=x;
+    if(x>k.max_x) k.max_x=x;
+    if(z<k.min_z) k.min_z=z;
+    if(z>k.max_z) k.max_z=z;
+    n=k.parent;
+  }
+  return true;
+}
+
+// The leaf o is in, or -1
+int KdTreeClass::Leaf(OrganismClass *o) {
+  int r=o->Row();
+  return (r<(signed int)leaf_of.size() ? leaf_of[r] : -1);
+}
+
+bool KdTreeClass::Leaf(OrganismClass *o,int n) {
+  int r=o->Row();
+  if(r>=(signed int)leaf_of.size()) leaf_of.resize(r+1,-1);
+  leaf_of[r]=n;
+  return true;
+}
+
+bool KdTreeClass::Insert(OrganismClass *o,long seq) {
+  IndexEntry e;
+  int n=0;
+  e.o=o;
+  e.seq=seq;
+  if(nodes.empty()) {
+    all.clear();
+    all.push_back(e);
+    Build(0,1,-1);
+  } else {
+    while(nodes[n].left>=0) {
+      double v=(nodes[n].axis ? Key(o->Pos().Z()) : Key(o->Pos().X()));
+      n=(v<nodes[n].split ? nodes[n].left : nodes[n].right);
+    }
+    nodes[n].items.push_back(e);
+    Leaf(o,n);
+    Grow(n,o->Pos());
+  }
+  count++;
+  changes++;
+  return true;
+}
+
+bool KdTreeClass::Remove(OrganismClass *o) {
+  int n=Leaf(o);
+  if(n<0) return false;
+  vector<IndexEntry> &items=nodes[n].items;
+  int i;
+  for(i=0;i<(signed int)items.size();i++) {
+    if(items[i].o==o) {
+      items[i]=items.back();
+      items.pop_back();
+      break;
+    }
+  }
+  Leaf(o,-1);
+  count--;
+  changes++;
+  return true;
+}
+
+bool KdTreeClass::Move(OrganismClass *o,VectorClass &) {
+  int n=Leaf(o);
+  if(n<0) return false;
+  if(Grow(n,o->Pos())) changes++;
+  return true;
+}
+
+bool KdTreeClass::Sequence(OrganismClass *o,long seq) {
+  int n=Leaf(o);
+  if(n<0) return false;
+  vector<IndexEntry> &items=nodes[n].items;
+  int i;
+  for(i=0;i<(signed int)items.size();i++) {
+    if(items[i].o==o) {
+      items[i].seq=seq;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool KdTreeClass::Overlaps(KdNode &k,VectorClass &p,double rx,double rz) {
+  return (k.min_x<=p.X()+rx && k.max_x>=p.X()-rx &&
+	  k.min_z<=p.Z()+rz && k.max_z>=p.Z()-rz);
+}
+
+bool KdTreeClass::Covers(VectorClass &p,double rx,double rz) {
+  Check();
+  if(nodes.empty()) return true;
+  KdNode &k=nodes[0];
+  return (k.min_x>=p.X()-rx && k.max_x<=p.X()+rx &&
+	  k.min_z>=p.Z()-rz && k.max_z<=p.Z()+rz);
+}
+
+int KdTreeClass::Query(VectorClass &p,double rx,double rz,
+		       vector<OrganismClass *> &list) {
+  int i,n=0,node;
+  Check();
+  if(nodes.empty()) return 0;
+  stack.clear();
+  stack.push_back(0);
+  while(!stack.empty()) {
+    node=stack.back();
+    stack.pop_back();
+    KdNode &k=nodes[node];
+    if(!Overlaps(k,p,rx,rz)) continue;
+    if(k.left>=0) {
+      stack.push_back(k.left);
+      stack.push_back(k.right);
+      continue;
+    }
+    for(i=0;i<(signed int)k.items.size();i++) {
+      OrganismClass *o=k.items[i].o;
+      if(fabs(o->Pos().X()-p.X())<=rx && fabs(o->Pos().Z()-p.Z())<=rz) {
+	list.push_back(o);
+	n++;
+      }
+    }
+  }
+  return n;
+}
+
+int KdTreeClass::QueryEntries(VectorClass &p,double rx,double rz,
+			      vector<IndexEntry> &list) {
+  int i,n=0,node;
+  Check();
+  if(nodes.empty()) return 0;
+  stack.clear();
+  stack.push_back(0);
+  while(!stack.empty()) {
+    node=stack.back();
+    stack.pop_back();
+    KdNode &k=nodes[node];
+    if(!Overlaps(k,p,rx,rz)) continue;
+    if(k.left>=0) {
+      stack.push_back(k.left);
+      stack.push_back(k.right);
+      continue;
+    }
+    for(i=0;i<(signed int)k.items.size();i++) {
+      OrganismClass *o=k.items[i].o;
+      if(fabs(o->Pos().X()-p.X())<=rx && fabs(o->Pos().Z()-p.Z())<=rz) {
+	list.push_back(k.items[i]);
+	n++;
+      }
+    }
+  }
+  return n;
+}
+
+OrganismClass *KdTreeClass::First(VectorClass &p,double rx,double rz,
+				  OrganismClass *skip,long *seq) {
+  IndexEntry *best=NULL;
+  int i,node;
+  Check();
+  if(nodes.empty()) return NULL;
+  stack.clear();
+  stack.push_back(0);
+  while(!stack.empty()) {
+    node=stack.back();
+    stack.pop_back();
+    KdNode &k=nodes[node];
+    if(!Overlaps(k,p,rx,rz)) continue;
+    if(k.left>=0) {
+      stack.push_back(k.left);
+      stack.push_back(k.right);
+      continue;
+    }
+    for(i=0;i<(signed int)k.items.size();i++) {
+      IndexEntry &e=k.items[i];
+      if(e.o==skip || (best && best->seq<e.seq)) continue;
+      if(fabs(e.o->Pos().X()-p.X())<=rx && fabs(e.o->Pos().Z()-p.Z())<=rz)
+	best=&e;
+    }
+  }
+  if(!best) return NULL;
+  if(seq) *seq=best->seq;
+  return best->o;
+}
+
+double KdTreeClass::CellSize() {
+  return cell_size;
+}
+
+const char *KdTreeClass::Name() {
+  return "kdtree";
+}
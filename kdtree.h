@@ -0,0 +1,75 @@
+/* 
+
+Copyright (C) 2000 Matthew Danish
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+#ifndef KDTREE_H_50627
+#define KDTREE_H_50627
+#include<vector>
+using namespace std;
+#include"spatial.h"
+
+// min and max hold everything that is or has been under the node
+// since the tree was built, so they only ever grow.  Leaves have
+// no children (left is -1) and hold the items.
+struct KdNode {
+  double min_x,min_z,max_x,max_z;
+  double split;
+  int axis;
+  int left,right,parent;
+  vector<IndexEntry> items;
+};
+
+// A k-d tree over the floor, split at the median of whichever of
+// X or Z is more spread out, down to KDTREE_LEAF_SIZE per leaf.
+// Moves only widen the bounds of the leaf and the nodes above it,
+// and the tree is built over once there have been as many changes
+// as there are things in it.  A move is a change only if it takes
+// something outside its leaf's bounds.  leaf_of is indexed by
+// vitals row, -1 for rows not in the tree.
+class KdTreeClass : public SpatialIndexClass {
+private:
+  vector<KdNode> nodes;
+  vector<int> leaf_of;
+  int count,changes;
+  double cell_size;
+  vector<IndexEntry> all;
+  vector<int> stack;
+  int Build(int,int,int);
+  bool Rebuild();
+  bool Grow(int,VectorClass &);
+  int Leaf(OrganismClass *);
+  bool Leaf(OrganismClass *,int);
+  bool Check();
+  bool Overlaps(KdNode &,VectorClass &,double,double);
+public:
+  KdTreeClass(double);
+  ~KdTreeClass();
+  bool Clear();
+  bool Insert(OrganismClass *,long);
+  bool Remove(OrganismClass *);
+  bool Move(OrganismClass *,VectorClass &);
+  bool Sequence(OrganismClass *,long);
+  bool Covers(VectorClass &,double,double);
+  int Query(VectorClass &,double,double,vector<OrganismClass *> &);
+  int QueryEntries(VectorClass &,double,double,vector<IndexEntry> &);
+  OrganismClass *First(VectorClass &,double,double,OrganismClass *,long *);
+  double CellSize();
+  const char *Name();
+};
+
+#endif
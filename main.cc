@@ -25,23 +25,46 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #include"universe.h"
 #include<time.h>
 #include<stdlib.h>
+#include<string.h>
 #include"defines.h"
+#include"spatial.h"
+#include"vitals.h"
+#include"brainpool.h"
+#include"hebbian.h"
+#include"nnkernel.h"
 using namespace std;
 
 int FLOOR_BLOCKS_X=6;
 int FLOOR_BLOCKS_Z=6;
 int NUM_ORGANISMS=3;
 int NUM_FOOD=3;
+int USE_GRID=1;
+int CHECK_GRID=0;
+double NEIGHBOR_SKIN=2;
+int SPATIAL_INDEX=INDEX_GRID;
+int BENCHMARK=0;
+long SOAK_TICKS=0;
+int REORDER_TICKS=100;
+int NEURODE_KERNEL=-1;
+int LOGISTIC=NN_LOGISTIC_EXACT;
+int FUSED_LEARNING=1;
+int BATCH_BRAINS=0;
+
+// every organism's energy, type and lifespan
+VitalsClass vitals;
+// brains of the dead, for the newborn
+BrainPoolClass brainpool;
 
 bool ShowLicense();
 
 bool ShowUsage(char *);
 
 bool ShowUsage(char *pn) {
-  printf("Usage: %s [ -x <num of blocks in x axis> | -z <num blocks in z axis> | -f <num of initial food> | <num of initial creatures> [<num of initial food>] | -v | -h]\n",pn);
+  printf("Usage: %s [ -x <num of blocks in x axis> | -z <num blocks in z axis> | -f <num of initial food> | <num of initial creatures> [<num of initial food>] | -g | -c | -s <neighbor list skin> | -i <grid|sweep|kdtree> | -b | -m <ticks> | -r <ticks> | -k <scalar|sse4.2|avx2|avx512> | -l <exact|fast> | -u | -t | -v | -h]\n",pn);
   printf("\nNote: You can specify food count either with -f or as the second positional argument.\n");
+  printf("\n-g turns off the spatial grid, every organism looks at the whole world.\n-c checks what the spatial grid sees against the whole world scan.\n-s sets how much farther out than needed the neighbor lists reach, 0 turns them off.\n-i picks what organisms and food are found by position with: a uniform grid,\nsweep and prune along X, or a k-d tree.\n-b times all three on the live population every few seconds, how\nlong a birth takes and how many allocations it makes, and each -k kernel.\n-m runs that many ticks without drawing anything, then reports how much\nmemory was in use at the most and once things settled down.\n-r sorts the organisms by where they are every that many ticks, 0 never.\n-k picks how brains add up their inputs, the best this CPU can run by default.\n-l picks how learning works out the logistic, exact (the default) or fast, within 4e-5.\n-u makes brains think and then learn in two passes instead of one.\n-t makes brains think together with the others of their shape, before anyone acts.\n");
   printf("\n-v prints the version.\n-h prints this help.\nRest are self explanatory.\nKeys\n~~~~\nYou start off in the middle of the \"world\"\nThe arrow keys move you around, up and down are forward and back,\nand right and left will turn you with respect to the y axis.\nPageUp moves you up the y axis and PageDown moves you down it.\nESC quits.\n");
-  printf("Defaults are: \n-x %d\n-z %d\n-f %d\nand initial creatures: %d\n",FLOOR_BLOCKS_X,FLOOR_BLOCKS_Z,NUM_FOOD,NUM_ORGANISMS);
+  printf("Defaults are: \n-x %d\n-z %d\n-f %d\n-s %g\n-r %d\n-i grid\nand initial creatures: %d\n",FLOOR_BLOCKS_X,FLOOR_BLOCKS_Z,NUM_FOOD,NEIGHBOR_SKIN,REORDER_TICKS,NUM_ORGANISMS);
   return true;
 }
 
@@ -74,6 +97,64 @@ int main(int argc, char *argv[]) {
 	i++;
 	NUM_FOOD = atoi(argv[i]);
 	break;
+      case 'g':
+	USE_GRID = 0;
+	break;
+      case 'c':
+	CHECK_GRID = 1;
+	break;
+      case 's':
+	i++;
+	NEIGHBOR_SKIN = atof(argv[i]);
+	break;
+      case 'i':
+	i++;
+	SPATIAL_INDEX = SpatialIndexKind(argv[i]);
+	if(SPATIAL_INDEX < 0) {
+	  printf("Unknown index '%s'.  Use '-h' for help.\n", argv[i]);
+	  return 1;
+	}
+	break;
+      case 'b':
+	BENCHMARK = 1;
+	break;
+      case 'm':
+	i++;
+	SOAK_TICKS = atol(argv[i]);
+	break;
+      case 'r':
+	i++;
+	REORDER_TICKS = atoi(argv[i]);
+	break;
+      case 'k':
+	i++;
+	NEURODE_KERNEL = NeurodeKernelKind(argv[i]);
+	if(NEURODE_KERNEL < 0) {
+	  printf("Unknown kernel '%s'.  Use '-h' for help.\n", argv[i]);
+	  return 1;
+	}
+	if(!NeuralNet::UseKernel(NEURODE_KERNEL)) {
+	  printf("This CPU can't run the %s kernel.\n", argv[i]);
+	  return 1;
+	}
+	break;
+      case 'u':
+	FUSED_LEARNING = 0;
+	break;
+      case 't':
+	BATCH_BRAINS = 1;
+	break;
+      case 'l':
+	i++;
+	if(!strcmp(argv[i],"exact"))
+	  LOGISTIC = NN_LOGISTIC_EXACT;
+	else if(!strcmp(argv[i],"fast"))
+	  LOGISTIC = NN_LOGISTIC_FAST;
+	else {
+	  printf("Unknown logistic '%s'.  Use '-h' for help.\n", argv[i]);
+	  return 1;
+	}
+	break;
       default:
 	printf("Unknown option '-%c'.  Use '-h' for help.\n", argv[i][1]);
 	break;
@@ -95,6 +176,11 @@ int main(int argc, char *argv[]) {
   if(NUM_ORGANISMS < 0) NUM_ORGANISMS = 1;
   if(FLOOR_BLOCKS_X < 0) FLOOR_BLOCKS_X = 4;
   if(FLOOR_BLOCKS_Z < 0) FLOOR_BLOCKS_Z = 4;
+  if(NEIGHBOR_SKIN < 0) NEIGHBOR_SKIN = 0;
+  if(SOAK_TICKS < 0) SOAK_TICKS = 0;
+  if(REORDER_TICKS < 0) REORDER_TICKS = 0;
+  if(NEURODE_KERNEL < 0) NEURODE_KERNEL = BestNeurodeKernel();
+  NeuralNet::UseLogistic(LOGISTIC);
 
 #ifndef DEBUG_OUTPUT
 #define DEBUG_OUTPUT 1  // Default to enabled if not defined
@@ -0,0 +1,184 @@
+/* 
+
+Copyright (C) 2000 Matthew Danish
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+#include<math.h>
+#include<vector>
+using namespace std;
+#include"neighbors.h"
+#include"spatial.h"
+#include"food.h"
+#include"org.h"
+#include"defines.h"
+
+/*
+ * neighbors.cc
+ *
+ * Organisms only move a little every tick, so the things near one
+ * hardly change from tick to tick.  A NeighborListClass remembers
+ * them, with some extra room (the skin) around the distance that
+ * is actually needed, and can be trusted until the organism and its
+ * neighbors could have moved far enough to use that room up.
+ */
+
+// Distance along X or Z, whichever is farther.  Comparisons with it
+// line up with the box queries that the grid answers.
+static double Span(VectorClass &a,VectorClass &b) {
+  double dx=fabs(a.X()-b.X()),dz=fabs(a.Z()-b.Z());
+  return (dx>dz ? dx : dz);
+}
+
+// The lists of organisms that are gone, kept (up to
+// ORGANISM_POOL_SIZE of them) so that newborns start out with room
+// instead of growing into it
+struct SpareList {
+  vector<IndexEntry> near;
+  vector<OrganismClass *> seen,seen_food;
+};
+static vector<SpareList> spare_lists;
+
+NeighborListClass::NeighborListClass() :
+  radius(0),
+  drift(0),
+  built(false)
+{
+  if(spare_lists.empty()) return;
+  SpareList &s=spare_lists.back();
+  near.swap(s.near);
+  seen.swap(s.seen);
+  seen_food.swap(s.seen_food);
+  spare_lists.pop_back();
+}
+
+NeighborListClass::~NeighborListClass() {
+  if(spare_lists.size()>=ORGANISM_POOL_SIZE) return;
+  spare_lists.push_back(SpareList());
+  SpareList &s=spare_lists.back();
+  near.clear();
+  seen.clear();
+  seen_food.clear();
+  s.near.swap(near);
+  s.seen.swap(seen);
+  s.seen_food.swap(seen_food);
+}
+
+// What Build() gets back from the food store, kept from one call to
+// the next
+static vector<OrganismClass *> found_food;
+
+// Puts everything within r of o on the list.  _drift is how far
+// anything could have moved by the start of this tick (see Trusted()).
+bool NeighborListClass::Build(OrganismClass *o,SpatialIndexClass *index,
+			      FoodStoreClass *food,double r,double _drift) {
+  vector<OrganismClass *> &f=found_food;
+  IndexEntry e;
+  int i;
+
+  near.clear();
+  ref=o->Pos();
+  radius=r;
+  drift=_drift;
+  built=true;
+
+  index->QueryEntries(ref,r,r,near);
+  for(i=0;i<(signed int)near.size();i++) {
+    if(near[i].o==o) {
+      near.erase(near.begin()+i);
+      break;
+    }
+  }
+
+  f.clear();
+  food->Query(ref,r,r,f);
+  e.seq=-1;
+  for(i=0;i<(signed int)f.size();i++) {
+    if(Span(f[i]->Pos(),ref)<=r) {
+      e.o=f[i];
+      near.push_back(e);
+    }
+  }
+  return true;
+}
+
+// How far from pos the list still holds everything there is.
+// _drift is the most anything else could have moved since the world
+// started, so _drift-drift bounds how far any neighbor has moved
+// since the list was built.  Below 0 the list is no good any more.
+double NeighborListClass::Trusted(VectorClass &pos,double _drift) {
+  if(!built) return -1;
+  return radius-Span(pos,ref)-(_drift-drift);
+}
+
+// Called for things that appear after the list was built
+bool NeighborListClass::Add(OrganismClass *o,long seq) {
+  if(!built || !(Span(o->Pos(),ref)<=radius)) return false;
+  IndexEntry e;
+  e.o=o;
+  e.seq=seq;
+  near.push_back(e);
+  return true;
+}
+
+static void PurgeSeen(vector<OrganismClass *> &list) {
+  int i,j=0;
+  for(i=0;i<(signed int)list.size();i++) {
+    if(list[i]->Type()!=ORGANISM_GONE)
+      list[j++]=list[i];
+  }
+  list.resize(j);
+}
+
+// Drops everything that has been taken out of the world
+bool NeighborListClass::Purge() {
+  int i,j=0;
+  for(i=0;i<(signed int)near.size();i++) {
+    if(near[i].o->Type()!=ORGANISM_GONE)
+      near[j++]=near[i];
+  }
+  near.resize(j);
+  PurgeSeen(seen);
+  PurgeSeen(seen_food);
+  return true;
+}
+
+bool NeighborListClass::Clear() {
+  near.clear();
+  seen.clear();
+  seen_food.clear();
+  built=false;
+  return true;
+}
+
+bool NeighborListClass::IsBuilt() {
+  return built;
+}
+
+int NeighborListClass::Size() {
+  return near.size();
+}
+
+IndexEntry & NeighborListClass::Entry(int i) {
+  return near[i];
+}
+
+// What was seen last tick, organisms (and food) if orgs is true,
+// or only food
+vector<OrganismClass *> & NeighborListClass::Seen(bool orgs) {
+  return (orgs ? seen : seen_food);
+}
@@ -0,0 +1,58 @@
+/* 
+
+Copyright (C) 2000 Matthew Danish
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+#ifndef NEIGHBORS_H_40917
+#define NEIGHBORS_H_40917
+#include<vector>
+using namespace std;
+#include"vector.h"
+#include"spatial.h"
+
+class OrganismClass;
+class FoodStoreClass;
+
+// The things that were near an organism when the list was built.
+// Everything within radius (measured along X or Z, whichever is
+// farther) of ref is on the list, plus anything that showed up
+// within that radius of ref later on.  Food is on the list with a
+// seq of -1.  It also remembers what the organism ended up seeing
+// last tick, closest first, for RepairOList().
+class NeighborListClass {
+private:
+  vector<IndexEntry> near;
+  vector<OrganismClass *> seen,seen_food;
+  VectorClass ref;
+  double radius,drift;
+  bool built;
+public:
+  NeighborListClass();
+  ~NeighborListClass();
+  bool Build(OrganismClass *,SpatialIndexClass *,FoodStoreClass *,double,double);
+  double Trusted(VectorClass &,double);
+  bool Add(OrganismClass *,long);
+  bool Purge();
+  bool Clear();
+  bool IsBuilt();
+  int Size();
+  IndexEntry & Entry(int);
+  vector<OrganismClass *> & Seen(bool);
+};
+
+#endif
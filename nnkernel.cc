@@ -0,0 +1,242 @@
+/* 
+
+Copyright (C) 2000 Matthew Danish
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+#include<string.h>
+#include"nnkernel.h"
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define NN_X86 1
+#include<immintrin.h>
+#else
+#define NN_X86 0
+#endif
+
+/*
+ * nnkernel.cc
+ *
+ * The innermost part of thinking: each neurode's weighted sum of its
+ * inputs.  The inputs are picked out by index, so the SIMD kinds
+ * gather them (by hand for SSE4.2, which has no gather) and sum a
+ * neurode's inputs 4, 8 or 16 at a time, or load them straight when
+ * a neurode's inputs are where they started (no indices).  The
+ * kinds are compiled in whatever the compiler flags say and picked
+ * when the program starts, by what the CPU says it can do.  The SIMD
+ * kinds add in a different order than the scalar one, so their sums
+ * can differ from it in the last bits.  Learning's logistic is here
+ * too.
+ */
+
+static const char *kernel_names[NUM_NN_KERNELS] = { "scalar", "sse4.2", "avx2", "avx512" };
+
+// The reference: exactly what RunNet() always did
+static void ScalarLayer(const float *w,const int *idx,int per,int count,
+			const float *src,int src_step,float *dst) {
+  int i,j;
+  for(i=0;i<count;i++,w+=per,src+=src_step) {
+    float sum=0;
+    if(idx) {
+      for(j=0;j<per;j++)
+	sum+=src[idx[j]]*w[j];
+      idx+=per;
+    } else {
+      for(j=0;j<per;j++)
+	sum+=src[j]*w[j];
+    }
+    dst[i]=sum;
+  }
+}
+
+#if NN_X86
+
+__attribute__((target("sse4.2")))
+static void SSE42Layer(const float *w,const int *idx,int per,int count,
+		       const float *src,int src_step,float *dst) {
+  int i,j;
+  if(per<4) {
+    ScalarLayer(w,idx,per,count,src,src_step,dst);
+    return;
+  }
+  for(i=0;i<count;i++,w+=per,src+=src_step) {
+    __m128 acc=_mm_setzero_ps();
+    float sum;
+    if(idx) {
+      for(j=0;j+4<=per;j+=4) {
+	__m128 x=_mm_set_ps(src[idx[j+3]],src[idx[j+2]],src[idx[j+1]],src[idx[j]]);
+	acc=_mm_add_ps(acc,_mm_mul_ps(x,_mm_loadu_ps(w+j)));
+      }
+    } else {
+      for(j=0;j+4<=per;j+=4)
+	acc=_mm_add_ps(acc,_mm_mul_ps(_mm_loadu_ps(src+j),_mm_loadu_ps(w+j)));
+    }
+    acc=_mm_hadd_ps(acc,acc);
+    acc=_mm_hadd_ps(acc,acc);
+    sum=_mm_cvtss_f32(acc);
+    for(;j<per;j++)
+      sum+=src[idx ? idx[j] : j]*w[j];
+    dst[i]=sum;
+    if(idx) idx+=per;
+  }
+}
+
+__attribute__((target("avx2")))
+static void AVX2Layer(const float *w,const int *idx,int per,int count,
+		      const float *src,int src_step,float *dst) {
+  int i,j;
+  if(per<8) {
+    ScalarLayer(w,idx,per,count,src,src_step,dst);
+    return;
+  }
+  for(i=0;i<count;i++,w+=per,src+=src_step) {
+    __m256 acc=_mm256_setzero_ps();
+    if(idx) {
+      for(j=0;j+8<=per;j+=8) {
+	__m256i at=_mm256_loadu_si256((const __m256i *)(idx+j));
+	__m256 x=_mm256_i32gather_ps(src,at,4);
+	acc=_mm256_add_ps(acc,_mm256_mul_ps(x,_mm256_loadu_ps(w+j)));
+      }
+    } else {
+      for(j=0;j+8<=per;j+=8)
+	acc=_mm256_add_ps(acc,_mm256_mul_ps(_mm256_loadu_ps(src+j),_mm256_loadu_ps(w+j)));
+    }
+    __m128 h=_mm_add_ps(_mm256_castps256_ps128(acc),_mm256_extractf128_ps(acc,1));
+    h=_mm_hadd_ps(h,h);
+    h=_mm_hadd_ps(h,h);
+    float sum=_mm_cvtss_f32(h);
+    for(;j<per;j++)
+      sum+=src[idx ? idx[j] : j]*w[j];
+    dst[i]=sum;
+    if(idx) idx+=per;
+  }
+}
+
+// GCC 12's AVX-512 header trips its own uninitialized warning
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+__attribute__((target("avx512f")))
+static void AVX512Layer(const float *w,const int *idx,int per,int count,
+			const float *src,int src_step,float *dst) {
+  int i,j;
+  // every CPU with AVX-512 has AVX2 for the narrower layers
+  if(per<16) {
+    AVX2Layer(w,idx,per,count,src,src_step,dst);
+    return;
+  }
+  for(i=0;i<count;i++,w+=per,src+=src_step) {
+    __m512 acc=_mm512_setzero_ps();
+    if(idx) {
+      for(j=0;j+16<=per;j+=16) {
+	__m512i at=_mm512_loadu_si512(idx+j);
+	__m512 x=_mm512_i32gather_ps(at,src,4);
+	acc=_mm512_add_ps(acc,_mm512_mul_ps(x,_mm512_loadu_ps(w+j)));
+      }
+    } else {
+      for(j=0;j+16<=per;j+=16)
+	acc=_mm512_add_ps(acc,_mm512_mul_ps(_mm512_loadu_ps(src+j),_mm512_loadu_ps(w+j)));
+    }
+    float sum=_mm512_reduce_add_ps(acc);
+    for(;j<per;j++)
+      sum+=src[idx ? idx[j] : j]*w[j];
+    dst[i]=sum;
+    if(idx) idx+=per;
+  }
+}
+#pragma GCC diagnostic pop
+
+#endif
+
+// 1/(1+e^-y)-0.5 is tanh(y/2)/2.  Up to LOGISTIC_CLAMP tanh is the
+// [7/6] Pade approximant below, past it it is within 1.4e-4 of 1
+// anyway.  That keeps the logistic within 4e-5 everywhere.
+#define LOGISTIC_CLAMP 4.8f
+
+static float Tanh(float t) {
+  if(t>LOGISTIC_CLAMP) t=LOGISTIC_CLAMP;
+  if(t<-LOGISTIC_CLAMP) t=-LOGISTIC_CLAMP;
+  float t2=t*t;
+  return t*(135135.0f+t2*(17325.0f+t2*(378.0f+t2)))/
+    (135135.0f+t2*(62370.0f+t2*(3150.0f+t2*28.0f)));
+}
+
+void LogisticFactors(float *x,int n,float alpha,float scale) {
+  float a=alpha*0.5f,s=scale*0.5f;
+  int i=0;
+
+#if NN_X86 && defined(__SSE2__)
+  __m128 va=_mm_set1_ps(a),vs=_mm_set1_ps(s);
+  __m128 hi=_mm_set1_ps(LOGISTIC_CLAMP),lo=_mm_set1_ps(-LOGISTIC_CLAMP);
+  for(;i+4<=n;i+=4) {
+    __m128 t=_mm_mul_ps(_mm_loadu_ps(x+i),va);
+    t=_mm_min_ps(_mm_max_ps(t,lo),hi);
+    __m128 t2=_mm_mul_ps(t,t);
+    __m128 p=_mm_add_ps(_mm_set1_ps(378.0f),t2);
+    p=_mm_add_ps(_mm_set1_ps(17325.0f),_mm_mul_ps(t2,p));
+    p=_mm_add_ps(_mm_set1_ps(135135.0f),_mm_mul_ps(t2,p));
+    p=_mm_mul_ps(t,p);
+    __m128 q=_mm_mul_ps(_mm_set1_ps(28.0f),t2);
+    q=_mm_add_ps(_mm_set1_ps(3150.0f),q);
+    q=_mm_add_ps(_mm_set1_ps(62370.0f),_mm_mul_ps(t2,q));
+    q=_mm_add_ps(_mm_set1_ps(135135.0f),_mm_mul_ps(t2,q));
+    _mm_storeu_ps(x+i,_mm_mul_ps(vs,_mm_div_ps(p,q)));
+  }
+#endif
+
+  // whatever is left over, or everything without SIMD
+  for(;i<n;i++)
+    x[i]=s*Tanh(a*x[i]);
+}
+
+LayerKernel NeurodeKernel(int kind) {
+#if NN_X86
+  // this can be called before main(), and before libgcc has looked
+  __builtin_cpu_init();
+#endif
+  switch(kind) {
+  case NN_KERNEL_SCALAR:
+    return ScalarLayer;
+#if NN_X86
+  case NN_KERNEL_SSE42:
+    return (__builtin_cpu_supports("sse4.2") ? SSE42Layer : 0);
+  case NN_KERNEL_AVX2:
+    return (__builtin_cpu_supports("avx2") ? AVX2Layer : 0);
+  case NN_KERNEL_AVX512:
+    return (__builtin_cpu_supports("avx512f") ? AVX512Layer : 0);
+#endif
+  default:
+    return 0;
+  }
+}
+
+int BestNeurodeKernel() {
+  int kind=NUM_NN_KERNELS-1;
+  while(kind>NN_KERNEL_SCALAR && !NeurodeKernel(kind))
+    kind--;
+  return kind;
+}
+
+int NeurodeKernelKind(const char *name) {
+  int i;
+  for(i=0;i<NUM_NN_KERNELS;i++) {
+    if(!strcmp(name,kernel_names[i])) return i;
+  }
+  return -1;
+}
+
+const char *NeurodeKernelName(int kind) {
+  if(kind<0 || kind>=NUM_NN_KERNELS) return "?";
+  return kernel_names[kind];
+}
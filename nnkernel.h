@@ -0,0 +1,54 @@
+/* 
+
+Copyright (C) 2000 Matthew Danish
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+#ifndef NNKERNEL_H_52961
+#define NNKERNEL_H_52961
+
+// Works out one layer of neurodes.  Neurode i of count has per
+// weights at w+i*per and as many input indices at idx+i*per, and its
+// output goes to dst[i].  Input j of neurode i is
+// src[i*src_step+idx[i*per+j]], so src can stay put (src_step 0, the
+// inputs) or slide along by one a neurode (the inner layers, which
+// read the neurodes right before them).  With idx NULL input j is
+// just src[i*src_step+j], and is loaded instead of gathered.
+// Neurodes are done in order, since the later ones can read what the
+// earlier ones wrote.
+typedef void (*LayerKernel)(const float *w,const int *idx,int per,int count,
+			    const float *src,int src_step,float *dst);
+
+// Turns each of the n outputs in x into scale*(1/(1+e^(-alpha*x))-0.5),
+// the logistic Learn() moves weights by.  It goes through a rational
+// approximation of tanh instead of exp, which is never more than 4e-5
+// off the exact logistic, and does 4 at a time with SSE2.
+void LogisticFactors(float *x,int n,float alpha,float scale);
+
+#define NN_KERNEL_SCALAR 0
+#define NN_KERNEL_SSE42 1
+#define NN_KERNEL_AVX2 2
+#define NN_KERNEL_AVX512 3
+#define NUM_NN_KERNELS 4
+
+// NULL if this CPU (or compiler) can't run that kind
+LayerKernel NeurodeKernel(int);
+// the fastest kind this CPU can run
+int BestNeurodeKernel();
+int NeurodeKernelKind(const char *);
+const char *NeurodeKernelName(int);
+
+#endif
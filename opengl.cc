@@ -262,10 +262,10 @@ bool OpenGLClass::DrawOrganism(OrganismClass *o) {
   return true;
 }
 
-bool OpenGLClass::DrawStack(stack<EventStack> &s) {
+bool OpenGLClass::DrawStack(stack<EventStack,vector<EventStack> > &s) {
   // Draw all flashes and manage their lifetime
   // Instead of popping immediately, we'll use a temporary stack to preserve active flashes
-  stack<EventStack> temp_stack;
+  stack<EventStack,vector<EventStack> > temp_stack;
   EventStack es;
 
   // Process all flashes: draw them and decrement their lifetime
@@ -21,6 +21,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #ifndef OPENGL_H_67548
 #define OPENGL_H_67548
 #include<stack>
+#include<vector>
 using namespace std;
 
 #include"conf.h"
@@ -64,7 +65,7 @@ public:
   bool DrawOrganism(OrganismClass *);
   bool SwapBuffers();
   bool Clear();
-  bool DrawStack(stack<EventStack> &);
+  bool DrawStack(stack<EventStack,vector<EventStack> > &);
   bool CheckInput(double &,double &,double &,double &,int &,int &);
   bool Screenshot(char *);
 };
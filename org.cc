@@ -24,27 +24,39 @@ using namespace std;
 #include"id.h"
 #include"energy.h"
 #include"hebbian.h"
+#include"vitals.h"
+#include"brainpool.h"
 #include"defines.h"
 
-OrganismClass::OrganismClass(IdToken *token,
-			     VectorClass *_position,
-			     AngleClass *_heading,
-			     GeneClass *_genes) :
-  id(new IdClass(*token)),
-  position(*_position),
-  heading(*_heading),
-  genes(*_genes)
+extern VitalsClass vitals;
+extern BrainPoolClass brainpool;
+
+// Memory of deleted organisms, handed out again by operator new
+static struct SpareOrgs {
+  vector<void *> p;
+  ~SpareOrgs() {
+    for(unsigned int i=0;i<p.size();i++)
+      ::operator delete(p[i]);
+  }
+} spare_orgs;
+
+// Everything handed in is copied, so it can live on the caller's stack
+OrganismClass::OrganismClass(IdToken &token,
+			     VectorClass &_position,
+			     AngleClass &_heading,
+			     GeneClass &_genes) :
+  row(vitals.Alloc(this,_position,_heading)),
+  size(_genes.Size()),
+  energy(row,size),
+  id(token),
+  genes(_genes),
+  seq(-1)
 {
-  delete token;
-  delete _position;
-  delete _heading;
-  delete _genes;
-  size.X(genes.Size().X());
-  size.Y(genes.Size().Y());
-  size.Z(genes.Size().Z());
-  lifespan = long(double(genes.Lifespan()) * (2 - genes.Metabolism()));
-  energy = new EnergyClass(size);
-  brain = new NeuralNet(genes.Brain().NumNeurodes(),
+  handle.slot=-1;
+  handle.gen=0;
+  vitals.Lifespan(row,long(double(genes.Lifespan()) * (2 - genes.Metabolism())));
+  vitals.Metabolism(row,genes.Metabolism());
+  brain = brainpool.Get(genes.Brain().NumNeurodes(),
 			genes.Brain().NumLayers(),
 			genes.Brain().NumInputs(),
 			genes.Brain().NumOutputs(),
@@ -53,21 +65,43 @@ OrganismClass::OrganismClass(IdToken *token,
 }
 
 OrganismClass::~OrganismClass() {
-  delete id;
-  delete energy;
-  delete brain;
+  brainpool.Put(brain);
+  vitals.Free(row);
+}
+
+// Organisms are born and die every tick, so the memory of dead ones
+// is kept (up to ORGANISM_POOL_SIZE of them) for the next ones
+void *OrganismClass::operator new(size_t size) {
+  if(size!=sizeof(OrganismClass) || spare_orgs.p.empty())
+    return ::operator new(size);
+  void *p=spare_orgs.p.back();
+  spare_orgs.p.pop_back();
+  return p;
+}
+
+void OrganismClass::operator delete(void *p) {
+  if(!p) return;
+  if(spare_orgs.p.size()<ORGANISM_POOL_SIZE)
+    spare_orgs.p.push_back(p);
+  else
+    ::operator delete(p);
 }
 
 IdClass & OrganismClass::Id() {
-  return *id;
+  return id;
+}
+
+// Which row of the VitalsClass is this organism's
+int OrganismClass::Row() {
+  return row;
 }
 
 VectorClass & OrganismClass::Pos() {
-  return position;
+  return vitals.Pos(row);
 }
 
 AngleClass & OrganismClass::Heading() {
-  return heading;
+  return vitals.Heading(row);
 }
 
 NeuralNet & OrganismClass::Brain() {
@@ -75,7 +109,7 @@ NeuralNet & OrganismClass::Brain() {
 }
 
 EnergyClass & OrganismClass::Energy() {
-  return *energy;
+  return energy;
 }
 
 GeneClass & OrganismClass::Genes() {
@@ -87,14 +121,19 @@ VectorClass & OrganismClass::Size() {
 }
 
 ColorClass & OrganismClass::Color() {
-  return color;
+  return vitals.Color(row);
+}
+
+NeighborListClass & OrganismClass::Neighbors() {
+  return neighbors;
 }
 
 short OrganismClass::Type() {
-  return type;
+  return vitals.Type(row);
 }
 
 short OrganismClass::Type(short t) {
+  ColorClass &color=vitals.Color(row);
   if(t==ORGANISM_LIVE) {
     // Initialize to black - colors will be set dynamically based on behavior
     // Red = aggression (set in UpdateOrganism based on outputs[3])
@@ -106,35 +145,31 @@ short OrganismClass::Type(short t) {
     color.R(1);
     color.G(1);
     color.B(0);
-    lifespan = DECAY_SPAN;
-  } else return type;
-  type=t;
-  return type;
+    vitals.Lifespan(row,DECAY_SPAN);
+  } else if(t!=ORGANISM_GONE) return vitals.Type(row);
+  return vitals.Type(row,t);
 }
-  
-bool OrganismClass::Lifetick() {
 
-  if(type==ORGANISM_LIVE) {
-    // Regenerate some health
-    Energy().Regen(Genes().Metabolism());
-    
-    
-    if(!--lifespan) {
-      Type(ORGANISM_FOOD);
-      Energy().TakeDamage(Energy().Health());
-      return false;
-    }
-    if(Energy().TakeDamage(Genes().Metabolism() * ENERGY_LOSS_PER_TICK * Energy().HealthCap())==false) {
-      Type(ORGANISM_FOOD);
-      return false;
-    }
-  } else {
-    // Food decay: lifespan counts down each tick
-    if(--lifespan<=0) {
-      // Food has fully decayed
-      return false;
-    }
-  }
+// When the organism was put in the world, the lower the earlier
+long OrganismClass::Seq() {
+  return seq;
+}
+
+long OrganismClass::Seq(long s) {
+  return (seq=s);
+}
 
-  return true;
+// Where it is in the OrganismStoreClass, if it is in one
+OrgHandle OrganismClass::Handle() {
+  return handle;
+}
+
+OrgHandle OrganismClass::Handle(OrgHandle h) {
+  return (handle=h);
+}
+  
+// Live organisms regenerate, age and starve, food decays.  Returns
+// false once it has died or decayed.
+bool OrganismClass::Lifetick() {
+  return vitals.Lifetick(row);
 }
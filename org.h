@@ -21,32 +21,39 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #ifndef ORG_H_86534
 #define ORG_H_86534
 
+#include<stddef.h>
 #include"vector.h"
 #include"angle.h"
 #include"gene.h"
 #include"color.h"
+#include"neighbors.h"
+#include"orgstore.h"
+#include"energy.h"
+#include"id.h"
 
 class NeuralNet;
-class EnergyClass;
-class IdClass;
-struct IdToken;
 
+// Position, heading, color, energy, type and lifespan live in the
+// organism's row of the VitalsClass (see vitals.h), everything else
+// is kept here.
 class OrganismClass {
 private:
+  int row;
   VectorClass size;
   NeuralNet *brain;
-  EnergyClass *energy;
-  IdClass *id;
-  VectorClass position;
-  AngleClass heading;
+  EnergyClass energy;
+  IdClass id;
   GeneClass genes;
-  ColorClass color;
-  short type;
-  long lifespan;
+  NeighborListClass neighbors;
+  long seq;
+  OrgHandle handle;
 public:
-  OrganismClass(IdToken *token,VectorClass *_position,AngleClass *_heading,GeneClass *_genes);
+  OrganismClass(IdToken &token,VectorClass &_position,AngleClass &_heading,GeneClass &_genes);
   ~OrganismClass();
+  static void *operator new(size_t);
+  static void operator delete(void *);
   IdClass & Id();
+  int Row();
   VectorClass & Pos();
   AngleClass & Heading();
   NeuralNet & Brain();
@@ -54,9 +61,14 @@ public:
   GeneClass & Genes();
   VectorClass & Size();
   ColorClass & Color();
+  NeighborListClass & Neighbors();
   bool Lifetick();
   short Type();
   short Type(short);
+  long Seq();
+  long Seq(long);
+  OrgHandle Handle();
+  OrgHandle Handle(OrgHandle);
 };
 
 #endif
@@ -0,0 +1,134 @@
+/* 
+
+Copyright (C) 2000 Matthew Danish
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+#include<stdlib.h>
+#include<vector>
+#include<utility>
+#include<algorithm>
+using namespace std;
+#include"orgstore.h"
+#include"org.h"
+
+/*
+ * orgstore.cc
+ *
+ * A slot map.  Every organism has a slot that stays the same for as
+ * long as it is in the store, and the slot knows where the organism
+ * is in the dense items array.  Empty slots are chained together
+ * through dense and handed out again newest first.
+ */
+
+OrganismStoreClass::OrganismStoreClass() :
+  free_slot(-1)
+{}
+
+OrganismStoreClass::~OrganismStoreClass() {
+  int i;
+  for(i=0;i<(signed int)items.size();i++)
+    delete items[i];
+}
+
+bool OrganismStoreClass::IsEmpty() {
+  return items.empty();
+}
+
+int OrganismStoreClass::Size() {
+  return items.size();
+}
+
+OrganismClass *OrganismStoreClass::Get(int i) {
+  return items[i];
+}
+
+// NULL if h's organism has been removed
+OrganismClass *OrganismStoreClass::Get(OrgHandle h) {
+  if(h.slot<0 || h.slot>=(signed int)slots.size() || slots[h.slot].gen!=h.gen)
+    return NULL;
+  return items[slots[h.slot].dense];
+}
+
+// Where h's organism is for Get(int), or -1 if it has been removed
+int OrganismStoreClass::Index(OrgHandle h) {
+  if(h.slot<0 || h.slot>=(signed int)slots.size() || slots[h.slot].gen!=h.gen)
+    return -1;
+  return slots[h.slot].dense;
+}
+
+OrgHandle OrganismStoreClass::Insert(OrganismClass *o) {
+  OrgHandle h;
+  if(free_slot>=0) {
+    h.slot=free_slot;
+    free_slot=slots[h.slot].dense;
+  } else {
+    Slot s;
+    s.gen=0;
+    h.slot=slots.size();
+    slots.push_back(s);
+  }
+  h.gen=slots[h.slot].gen;
+  slots[h.slot].dense=items.size();
+  items.push_back(o);
+  item_slot.push_back(h.slot);
+  return h;
+}
+
+// Takes h's organism out of the store and returns it, or NULL if it
+// was already gone.  The last organism takes its place in the order.
+OrganismClass *OrganismStoreClass::Remove(OrgHandle h) {
+  OrganismClass *o=Get(h);
+  if(!o) return NULL;
+  int i=slots[h.slot].dense;
+  int last=items.size()-1;
+
+  if(i!=last) {
+    items[i]=items[last];
+    item_slot[i]=item_slot[last];
+    slots[item_slot[i]].dense=i;
+  }
+  items.pop_back();
+  item_slot.pop_back();
+
+  slots[h.slot].gen++;
+  slots[h.slot].dense=free_slot;
+  free_slot=h.slot;
+  return o;
+}
+
+// Sorts the organisms by keys, which has one key for each of them in
+// the order Get(int) gives them.  Ties stay in the order they were
+// in.  Only the dense order changes, so every handle stays good.
+bool OrganismStoreClass::Reorder(vector<unsigned int> &keys) {
+  int i,n=items.size();
+  if((signed int)keys.size()!=n) return false;
+
+  order.resize(n);
+  for(i=0;i<n;i++)
+    order[i]=make_pair(keys[i],i);
+  sort(order.begin(),order.end());
+
+  old_items=items;
+  old_slot=item_slot;
+  for(i=0;i<n;i++) {
+    items[i]=old_items[order[i].second];
+    item_slot[i]=old_slot[order[i].second];
+    slots[item_slot[i]].dense=i;
+  }
+  return true;
+}
@@ -0,0 +1,74 @@
+/* 
+
+Copyright (C) 2000 Matthew Danish
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+#ifndef ORGSTORE_H_61203
+#define ORGSTORE_H_61203
+#include<vector>
+#include<utility>
+using namespace std;
+
+class OrganismClass;
+
+// Names a slot in an OrganismStoreClass.  gen goes up every time the
+// slot is emptied, so a handle kept after its organism was removed
+// no longer finds anything, even once the slot is used again.
+struct OrgHandle {
+  int slot;
+  unsigned int gen;
+};
+
+// The live organisms, kept densely packed for walking through with
+// Size() and Get(int), and found again by the handle Insert() gave
+// back.  Inserting and removing take the same time however many
+// organisms there are; removing one moves the last one into its
+// place.  There is no cursor, so any number of loops can walk the
+// store at once.  The store deletes whatever is left in it when it
+// is deleted, but organisms taken out with Remove() are up to the
+// caller.  Reorder() shuffles the dense order around, say to put
+// organisms that are near each other one after another; handles
+// still find the same organisms afterwards.
+class OrganismStoreClass {
+private:
+  struct Slot {
+    unsigned int gen;
+    int dense; // where it is in items, or the next free slot
+  };
+  vector<Slot> slots;
+  vector<OrganismClass *> items;
+  vector<int> item_slot;
+  int free_slot;
+  // kept from one Reorder() to the next
+  vector<pair<unsigned int,int> > order;
+  vector<OrganismClass *> old_items;
+  vector<int> old_slot;
+public:
+  OrganismStoreClass();
+  ~OrganismStoreClass();
+  bool IsEmpty();
+  int Size();
+  OrganismClass *Get(int);
+  OrganismClass *Get(OrgHandle);
+  int Index(OrgHandle);
+  OrgHandle Insert(OrganismClass *);
+  OrganismClass *Remove(OrgHandle);
+  bool Reorder(vector<unsigned int> &);
+};
+
+#endif
@@ -20,6 +20,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 
 #include<iostream>
 #include<vector>
+#include<algorithm>
 using namespace std;
 #include"quicksort.h"
 
@@ -60,3 +61,77 @@ void QuickSortOList(vector<OList> &list) {
     list[i+lowlist.size()]=hilist[i];
   }
 }  
+
+static bool OListCloser(const OList &a,const OList &b) {
+  return a.dist < b.dist;
+}
+
+// Keeps only the k closest entries of list, sorted closest first.
+// Cheaper than sorting everything when only a few get used.
+void SelectOList(vector<OList> &list,int k) {
+  if(k<=0) {
+    list.clear();
+    return;
+  }
+  if(k<(signed int)list.size()) {
+    nth_element(list.begin(),list.begin()+k,list.end(),OListCloser);
+    list.resize(k);
+  }
+  sort(list.begin(),list.end(),OListCloser);
+}
+
+// Does the same as SelectOList(), but starts from last, the things
+// that were kept last time closest first.  Those are put back in
+// their old order and the closest k newcomers after them, then an
+// insertion sort sets the order straight; when things have hardly
+// moved it has little to do.  last is updated to what was kept and
+// scratch is only used to work in.  Returns how many places entries
+// had to be moved by the insertion sort.
+long RepairOList(vector<OList> &list,vector<OrganismClass *> &last,int k,
+		 vector<OList> &scratch) {
+  int i,j,n=list.size();
+  long swaps=0;
+  OList tmp;
+
+  if(k<=0) {
+    list.clear();
+    last.clear();
+    return 0;
+  }
+
+  // whatever is still around goes first, in the old order
+  scratch.clear();
+  for(j=0;j<(signed int)last.size();j++) {
+    for(i=0;i<n;i++) {
+      if(list[i].seen==last[j]) {
+	scratch.push_back(list[i]);
+	list[i].seen=NULL;
+	break;
+      }
+    }
+  }
+
+  // then the closest of the rest
+  for(i=j=0;i<n;i++) {
+    if(list[i].seen) list[j++]=list[i];
+  }
+  list.resize(j);
+  SelectOList(list,k);
+  scratch.insert(scratch.end(),list.begin(),list.end());
+
+  for(i=1;i<(signed int)scratch.size();i++) {
+    tmp=scratch[i];
+    for(j=i;j>0 && scratch[j-1].dist>tmp.dist;j--) {
+      scratch[j]=scratch[j-1];
+      swaps++;
+    }
+    scratch[j]=tmp;
+  }
+  if((signed int)scratch.size()>k) scratch.resize(k);
+
+  list.swap(scratch);
+  last.resize(list.size());
+  for(i=0;i<(signed int)list.size();i++)
+    last[i]=list[i].seen;
+  return swaps;
+}
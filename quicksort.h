@@ -25,14 +25,19 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #include"angle.h"
 #include"color.h"
 
+class OrganismClass;
+
 struct OList {
   VectorClass distv;
-  double dist;
+  real dist;
   AngleClass heading;
   ColorClass color;
+  OrganismClass *seen;
 };
 
 void QuickSortOList(vector<OList> &);
+void SelectOList(vector<OList> &,int);
+long RepairOList(vector<OList> &,vector<OrganismClass *> &,int,vector<OList> &);
 
 
 #endif
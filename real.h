@@ -18,39 +18,20 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 
 */
 
-#ifndef ORGLIST_H_85445
-#define ORGLIST_H_85445
-
-class OrganismClass;
-class IdClass;
-
-struct OrganismListStruct {
-  OrganismClass *o;
-  OrganismListStruct *next,*prev;
-};
-
-
-class OrganismListClass {
-private:
-  OrganismListStruct *cur,*start,*end;
-public:
-  OrganismListClass();
-  ~OrganismListClass();
-  bool IsEmpty();
-  bool Append(OrganismClass *);
-  bool Prepend(OrganismClass *);
-  OrganismClass *First();
-  OrganismClass *Last();
-  OrganismClass *Next();
-  OrganismClass *Prev();
-  bool Rewind();
-  OrganismClass *N(int);
-  OrganismClass *Cur();
-  OrganismClass *Id(IdClass &);
-  bool Pop(); // remove from start
-  bool Dequeue(); // remove from end
-  bool Remove(int);
-  bool Remove(IdClass &);
-};
+#ifndef REAL_H_20417
+#define REAL_H_20417
+
+// What positions, headings, colors, energy and what organisms see
+// are stored in.  Building with SINGLE_PRECISION=1 makes that float,
+// which halves them; the math on them is still done in double.
+#ifndef SINGLE_PRECISION
+#define SINGLE_PRECISION 0
+#endif
+
+#if SINGLE_PRECISION
+typedef float real;
+#else
+typedef double real;
+#endif
 
 #endif
@@ -0,0 +1,127 @@
+/* 
+
+Copyright (C) 2000 Matthew Danish
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+#include"sight.h"
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIGHT_X86 1
+#include<immintrin.h>
+#else
+#define SIGHT_X86 0
+#endif
+
+/*
+ * sight.cc
+ *
+ * The innermost part of vision: which things are in front of an
+ * organism and how far away they are, a few at a time.  Distances
+ * are left squared, so only the handful that end up as inputs need
+ * a square root.  Everything lies on the floor, so Y is left out.
+ * There is a scalar, an SSE2 and an AVX2 kind, all compiled in, and
+ * the best one this CPU can run is picked when the program starts.
+ * They all do the same arithmetic, so they give the same answers.
+ */
+
+typedef int (*SightFunc)(double,double,double,double,
+			 const double *,const double *,int,
+			 double *,unsigned char *);
+
+// whatever is left over from the SIMD kinds, or everything
+static inline int SightTail(double ox,double oz,double hx,double hz,
+			    const double *x,const double *z,int i,int n,
+			    double *dist2,unsigned char *front) {
+  int seen=0;
+  for(;i<n;i++) {
+    double dx=x[i]-ox,dz=z[i]-oz;
+    dist2[i]=dx*dx+dz*dz;
+    front[i]=(dx*hx+dz*hz>0);
+    seen+=front[i];
+  }
+  return seen;
+}
+
+static int ScalarSight(double ox,double oz,double hx,double hz,
+		       const double *x,const double *z,int n,
+		       double *dist2,unsigned char *front) {
+  return SightTail(ox,oz,hx,hz,x,z,0,n,dist2,front);
+}
+
+#if SIGHT_X86
+__attribute__((target("sse2")))
+static int SSE2Sight(double ox,double oz,double hx,double hz,
+		     const double *x,const double *z,int n,
+		     double *dist2,unsigned char *front) {
+  int i=0,seen=0,m;
+  __m128d vox=_mm_set1_pd(ox),voz=_mm_set1_pd(oz);
+  __m128d vhx=_mm_set1_pd(hx),vhz=_mm_set1_pd(hz);
+  __m128d zero=_mm_setzero_pd();
+  for(;i+2<=n;i+=2) {
+    __m128d dx=_mm_sub_pd(_mm_loadu_pd(x+i),vox);
+    __m128d dz=_mm_sub_pd(_mm_loadu_pd(z+i),voz);
+    __m128d dot=_mm_add_pd(_mm_mul_pd(dx,vhx),_mm_mul_pd(dz,vhz));
+    _mm_storeu_pd(dist2+i,_mm_add_pd(_mm_mul_pd(dx,dx),_mm_mul_pd(dz,dz)));
+    m=_mm_movemask_pd(_mm_cmpgt_pd(dot,zero));
+    front[i]=m&1;
+    front[i+1]=(m>>1)&1;
+    seen+=front[i]+front[i+1];
+  }
+  return seen+SightTail(ox,oz,hx,hz,x,z,i,n,dist2,front);
+}
+
+__attribute__((target("avx2")))
+static int AVX2Sight(double ox,double oz,double hx,double hz,
+		     const double *x,const double *z,int n,
+		     double *dist2,unsigned char *front) {
+  int i=0,seen=0,m;
+  __m256d vox=_mm256_set1_pd(ox),voz=_mm256_set1_pd(oz);
+  __m256d vhx=_mm256_set1_pd(hx),vhz=_mm256_set1_pd(hz);
+  __m256d zero=_mm256_setzero_pd();
+  for(;i+4<=n;i+=4) {
+    __m256d dx=_mm256_sub_pd(_mm256_loadu_pd(x+i),vox);
+    __m256d dz=_mm256_sub_pd(_mm256_loadu_pd(z+i),voz);
+    __m256d dot=_mm256_add_pd(_mm256_mul_pd(dx,vhx),_mm256_mul_pd(dz,vhz));
+    _mm256_storeu_pd(dist2+i,_mm256_add_pd(_mm256_mul_pd(dx,dx),
+					   _mm256_mul_pd(dz,dz)));
+    m=_mm256_movemask_pd(_mm256_cmp_pd(dot,zero,_CMP_GT_OQ));
+    front[i]=m&1;
+    front[i+1]=(m>>1)&1;
+    front[i+2]=(m>>2)&1;
+    front[i+3]=(m>>3)&1;
+    seen+=front[i]+front[i+1]+front[i+2]+front[i+3];
+  }
+  return seen+SightTail(ox,oz,hx,hz,x,z,i,n,dist2,front);
+}
+#endif
+
+static SightFunc BestSight() {
+#if SIGHT_X86
+  // this is called before main(), and before libgcc has looked
+  __builtin_cpu_init();
+  if(__builtin_cpu_supports("avx2")) return AVX2Sight;
+  if(__builtin_cpu_supports("sse2")) return SSE2Sight;
+#endif
+  return ScalarSight;
+}
+
+static SightFunc sight=BestSight();
+
+int SightKernel(double ox,double oz,double hx,double hz,
+		const double *x,const double *z,int n,
+		double *dist2,unsigned char *front) {
+  return sight(ox,oz,hx,hz,x,z,n,dist2,front);
+}
@@ -0,0 +1,31 @@
+/* 
+
+Copyright (C) 2000 Matthew Danish
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+#ifndef SIGHT_H_25813
+#define SIGHT_H_25813
+
+// For each of n things at (x[i],z[i]), works out its squared distance
+// from (ox,oz) into dist2[i], and sets front[i] to 1 if it is in front
+// of the heading (hx,hz), 0 if not.  Returns how many are in front.
+// Uses AVX2 or SSE2 when the CPU has them.
+int SightKernel(double ox,double oz,double hx,double hz,
+		const double *x,const double *z,int n,
+		double *dist2,unsigned char *front);
+
+#endif
@@ -0,0 +1,55 @@
+/* 
+
+Copyright (C) 2000 Matthew Danish
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+#include<string.h>
+#include"spatial.h"
+#include"grid.h"
+#include"sweep.h"
+#include"kdtree.h"
+
+/*
+ * spatial.cc
+ *
+ * Picks which kind of SpatialIndexClass to use.  The grid is best
+ * when things are spread out, the other two when they bunch up.
+ */
+
+static const char *index_names[NUM_INDEXES] = { "grid", "sweep", "kdtree" };
+
+SpatialIndexClass::~SpatialIndexClass() {}
+
+SpatialIndexClass *NewSpatialIndex(int kind,double min_x,double min_z,
+				   double max_x,double max_z,double cs) {
+  switch(kind) {
+  case INDEX_SWEEP:
+    return new SweepPruneClass(cs);
+  case INDEX_KDTREE:
+    return new KdTreeClass(cs);
+  default:
+    return new SpatialGridClass(min_x,min_z,max_x,max_z,cs);
+  }
+}
+
+int SpatialIndexKind(const char *name) {
+  int i;
+  for(i=0;i<NUM_INDEXES;i++) {
+    if(!strcmp(name,index_names[i])) return i;
+  }
+  return -1;
+}
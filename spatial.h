@@ -0,0 +1,73 @@
+/* 
+
+Copyright (C) 2000 Matthew Danish
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+#ifndef SPATIAL_H_73055
+#define SPATIAL_H_73055
+#include<vector>
+using namespace std;
+
+class OrganismClass;
+class VectorClass;
+
+// seq is handed in by whoever puts o in the index.  The organisms
+// use the order they came into the world in (OrganismClass::Seq()),
+// the food store uses where the food sits in the store.
+struct IndexEntry {
+  OrganismClass *o;
+  long seq;
+};
+
+// Something that can find the organisms (or food) near a spot on the
+// floor.  It must be told whenever something is added, removed, or
+// moved.  All the boxes are centered at p, rx by rz in half-size.
+class SpatialIndexClass {
+public:
+  virtual ~SpatialIndexClass();
+  virtual bool Clear()=0;
+  virtual bool Insert(OrganismClass *,long)=0;
+  virtual bool Remove(OrganismClass *)=0;
+  // call after o has moved, the VectorClass is where it was before
+  virtual bool Move(OrganismClass *,VectorClass &)=0;
+  virtual bool Sequence(OrganismClass *,long)=0;
+  // true if Query() with this box hands back everything there is
+  virtual bool Covers(VectorClass &,double,double)=0;
+  // appends at least everything in the box, maybe more
+  virtual int Query(VectorClass &,double,double,vector<OrganismClass *> &)=0;
+  // appends exactly what is in the box
+  virtual int QueryEntries(VectorClass &,double,double,vector<IndexEntry> &)=0;
+  // of everything but the skipped one in the box, the one with the
+  // lowest seq, or NULL.  Its seq is put in the long if it is given.
+  virtual OrganismClass *First(VectorClass &,double,double,OrganismClass *,long *)=0;
+  // how big a box is worth starting a search with
+  virtual double CellSize()=0;
+  virtual const char *Name()=0;
+};
+
+#define INDEX_GRID 0
+#define INDEX_SWEEP 1
+#define INDEX_KDTREE 2
+#define NUM_INDEXES 3
+
+// Makes an index of the given kind over the floor from min_x,min_z
+// to max_x,max_z.  cs is the side of a grid cell.
+SpatialIndexClass *NewSpatialIndex(int,double,double,double,double,double);
+// Turns "grid", "sweep" or "kdtree" into one of the above, or -1
+int SpatialIndexKind(const char *);
+
+#endif
@@ -0,0 +1,180 @@
+/* 
+
+Copyright (C) 2000 Matthew Danish
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+#include<math.h>
+#include<vector>
+using namespace std;
+#include"sweep.h"
+#include"vector.h"
+#include"org.h"
+
+/*
+ * sweep.cc
+ *
+ * One dimensional sweep and prune.  Organisms only move a little at
+ * a time, so after a move the list is put back in order by sliding
+ * the one that moved past its neighbors.
+ */
+
+// NaNs would break the ordering, they are kept at the very front
+static double Key(double x) {
+  return (x==x ? x : -HUGE_VAL);
+}
+
+// cs is only used as the size to start searches at
+SweepPruneClass::SweepPruneClass(double cs) :
+  cell_size(cs)
+{
+  Clear();
+}
+
+SweepPruneClass::~SweepPruneClass() {}
+
+// Index of the first entry at or after x
+int SweepPruneClass::Lower(double x) {
+  int lo=0,hi=items.size(),mid;
+  while(lo<hi) {
+    mid=(lo+hi)/2;
+    if(items[mid].x<x) lo=mid+1;
+    else hi=mid;
+  }
+  return lo;
+}
+
+// Where o is, x being the key it was put in at, or -1
+int SweepPruneClass::Find(OrganismClass *o,double x) {
+  int i;
+  for(i=Lower(x);i<(signed int)items.size() && items[i].x==x;i++) {
+    if(items[i].e.o==o) return i;
+  }
+  return -1;
+}
+
+bool SweepPruneClass::SeeZ(double z) {
+  z=Key(z);
+  if(z<min_z) min_z=z;
+  if(z>max_z) max_z=z;
+  return true;
+}
+
+bool SweepPruneClass::Clear() {
+  items.clear();
+  min_z=HUGE_VAL;
+  max_z=-HUGE_VAL;
+  return true;
+}
+
+bool SweepPruneClass::Insert(OrganismClass *o,long seq) {
+  SweepEntry s;
+  s.x=Key(o->Pos().X());
+  s.e.o=o;
+  s.e.seq=seq;
+  int i=Lower(s.x);
+  while(i<(signed int)items.size() && items[i].x==s.x) i++;
+  items.insert(items.begin()+i,s);
+  SeeZ(o->Pos().Z());
+  return true;
+}
+
+bool SweepPruneClass::Remove(OrganismClass *o) {
+  int i=Find(o,Key(o->Pos().X()));
+  if(i<0) return false;
+  items.erase(items.begin()+i);
+  return true;
+}
+
+bool SweepPruneClass::Move(OrganismClass *o,VectorClass &old) {
+  int i=Find(o,Key(old.X()));
+  if(i<0) return false;
+  SweepEntry s=items[i];
+  s.x=Key(o->Pos().X());
+  while(i>0 && items[i-1].x>s.x) {
+    items[i]=items[i-1];
+    i--;
+  }
+  while(i+1<(signed int)items.size() && items[i+1].x<s.x) {
+    items[i]=items[i+1];
+    i++;
+  }
+  items[i]=s;
+  SeeZ(o->Pos().Z());
+  return true;
+}
+
+bool SweepPruneClass::Sequence(OrganismClass *o,long seq) {
+  int i=Find(o,Key(o->Pos().X()));
+  if(i<0) return false;
+  items[i].e.seq=seq;
+  return true;
+}
+
+bool SweepPruneClass::Covers(VectorClass &p,double rx,double rz) {
+  if(items.empty()) return true;
+  return (items.front().x>=p.X()-rx && items.back().x<=p.X()+rx &&
+	  min_z>=p.Z()-rz && max_z<=p.Z()+rz);
+}
+
+int SweepPruneClass::Query(VectorClass &p,double rx,double rz,
+			   vector<OrganismClass *> &list) {
+  int i,n=0;
+  for(i=Lower(p.X()-rx);i<(signed int)items.size() && items[i].x<=p.X()+rx;i++) {
+    if(fabs(items[i].e.o->Pos().X()-p.X())<=rx &&
+       fabs(items[i].e.o->Pos().Z()-p.Z())<=rz) {
+      list.push_back(items[i].e.o);
+      n++;
+    }
+  }
+  return n;
+}
+
+int SweepPruneClass::QueryEntries(VectorClass &p,double rx,double rz,
+				  vector<IndexEntry> &list) {
+  int i,n=0;
+  for(i=Lower(p.X()-rx);i<(signed int)items.size() && items[i].x<=p.X()+rx;i++) {
+    if(fabs(items[i].e.o->Pos().X()-p.X())<=rx &&
+       fabs(items[i].e.o->Pos().Z()-p.Z())<=rz) {
+      list.push_back(items[i].e);
+      n++;
+    }
+  }
+  return n;
+}
+
+OrganismClass *SweepPruneClass::First(VectorClass &p,double rx,double rz,
+				      OrganismClass *skip,long *seq) {
+  IndexEntry *best=NULL;
+  int i;
+  for(i=Lower(p.X()-rx);i<(signed int)items.size() && items[i].x<=p.X()+rx;i++) {
+    IndexEntry &e=items[i].e;
+    if(e.o==skip || (best && best->seq<e.seq)) continue;
+    if(fabs(e.o->Pos().X()-p.X())<=rx && fabs(e.o->Pos().Z()-p.Z())<=rz)
+      best=&e;
+  }
+  if(!best) return NULL;
+  if(seq) *seq=best->seq;
+  return best->o;
+}
+
+double SweepPruneClass::CellSize() {
+  return cell_size;
+}
+
+const char *SweepPruneClass::Name() {
+  return "sweep";
+}
@@ -0,0 +1,59 @@
+/* 
+
+Copyright (C) 2000 Matthew Danish
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+#ifndef SWEEP_H_18342
+#define SWEEP_H_18342
+#include<vector>
+using namespace std;
+#include"spatial.h"
+
+struct SweepEntry {
+  double x;
+  IndexEntry e;
+};
+
+// Everything kept sorted along X.  A box query only has to look at
+// the stretch of the list between its left and right edges, which
+// stays short when things are bunched up in a few spots.
+class SweepPruneClass : public SpatialIndexClass {
+private:
+  vector<SweepEntry> items;
+  // the lowest and highest Z anything has been at since Clear()
+  double min_z,max_z;
+  double cell_size;
+  int Lower(double);
+  int Find(OrganismClass *,double);
+  bool SeeZ(double);
+public:
+  SweepPruneClass(double);
+  ~SweepPruneClass();
+  bool Clear();
+  bool Insert(OrganismClass *,long);
+  bool Remove(OrganismClass *);
+  bool Move(OrganismClass *,VectorClass &);
+  bool Sequence(OrganismClass *,long);
+  bool Covers(VectorClass &,double,double);
+  int Query(VectorClass &,double,double,vector<OrganismClass *> &);
+  int QueryEntries(VectorClass &,double,double,vector<IndexEntry> &);
+  OrganismClass *First(VectorClass &,double,double,OrganismClass *,long *);
+  double CellSize();
+  const char *Name();
+};
+
+#endif
@@ -21,6 +21,8 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #include<iostream>
 #include<stdio.h>
 #include<math.h>
+#include<time.h>
+#include<algorithm>
 using namespace std;
 #include"universe.h"
 
@@ -32,7 +34,7 @@ using namespace std;
 #endif
 #include"opengl.h"
 #include"world.h"
-#include"orglist.h"
+#include"orgstore.h"
 #include"idserver.h"
 #include"id.h"
 #include"angle.h"
@@ -44,6 +46,12 @@ using namespace std;
 #include"hebbian.h"
 #include"defines.h"
 #include"quicksort.h"
+#include"spatial.h"
+#include"food.h"
+#include"sight.h"
+#include"vitals.h"
+#include"brainpool.h"
+#include"nnkernel.h"
 
 /*
  * universe.cc
@@ -63,6 +71,12 @@ float abs_f(float);
 int SortOListFunc(OList *,OList *);
 
 extern int FLOOR_BLOCKS_Z,FLOOR_BLOCKS_X,NUM_FOOD,NUM_ORGANISMS;
+extern int USE_GRID,CHECK_GRID,SPATIAL_INDEX,BENCHMARK;
+extern long SOAK_TICKS,ALLOCATIONS;
+extern int REORDER_TICKS,NEURODE_KERNEL,LOGISTIC,FUSED_LEARNING,BATCH_BRAINS;
+extern double NEIGHBOR_SKIN;
+extern VitalsClass vitals;
+extern BrainPoolClass brainpool;
 
 /*
  * Some Utility functions
@@ -84,22 +98,145 @@ float abs_f(float n) {
   return (n > 0 ? n : -n);
 }
 
+// Orders contacts by who reaches, then by who is reached
+static bool ContactBefore(const ContactPair &a,const ContactPair &b) {
+  if(a.a_seq!=b.a_seq) return a.a_seq<b.a_seq;
+  return a.b_seq<b.b_seq;
+}
+
+// Orders organisms by when they were put in the world
+static bool SeqBefore(OrganismClass *a,OrganismClass *b) {
+  return a->Seq()<b->Seq();
+}
+
+// Same shape of brain, as BrainPoolClass files them
+static bool SameShape(NeuralNet &a,NeuralNet &b) {
+  return (a.NumNeurodes()==b.NumNeurodes() && a.NumLayers()==b.NumLayers() &&
+	  a.NumInputs()==b.NumInputs() && a.NumOutputs()==b.NumOutputs());
+}
+
+// How many of the live brains' neurodes go the dense way (see
+// NeuralNet::Rewire()), and how many are gathered
+static void CountDense(OrganismStoreClass *store,long &dense,long &gathered) {
+  int i;
+  dense=gathered=0;
+  for(i=0;i<store->Size();i++) {
+    NeuralNet &nn=store->Get(i)->Brain();
+    dense+=nn.NumDense();
+    gathered+=nn.NumNeurodes()+nn.NumOutputs()-nn.NumDense();
+  }
+}
+
+// Orders organisms by the shape of their brains, then like SeqBefore()
+static bool ShapeBefore(OrganismClass *a,OrganismClass *b) {
+  NeuralNet &x=a->Brain(),&y=b->Brain();
+  if(x.NumNeurodes()!=y.NumNeurodes()) return x.NumNeurodes()<y.NumNeurodes();
+  if(x.NumLayers()!=y.NumLayers()) return x.NumLayers()<y.NumLayers();
+  if(x.NumInputs()!=y.NumInputs()) return x.NumInputs()<y.NumInputs();
+  if(x.NumOutputs()!=y.NumOutputs()) return x.NumOutputs()<y.NumOutputs();
+  return a->Seq()<b->Seq();
+}
+
+// Spreads the low 16 bits of x out to the even bits
+static unsigned int SpreadBits(unsigned int x) {
+  x&=0xffff;
+  x=(x|(x<<8))&0x00ff00ff;
+  x=(x|(x<<4))&0x0f0f0f0f;
+  x=(x|(x<<2))&0x33333333;
+  x=(x|(x<<1))&0x55555555;
+  return x;
+}
+
+// Z-order (Morton) key of where o is, one floor quad to a step.
+// Interleaving the bits of X and Z keeps most things that are close
+// together in the world close together in key order too.
+static unsigned int MortonKey(OrganismClass *o) {
+  double x=(o->Pos().X()/FLOOR_QUAD_SIZE)+FLOOR_BLOCKS_X/2+1;
+  double z=(o->Pos().Z()/FLOOR_QUAD_SIZE)+FLOOR_BLOCKS_Z/2+1;
+  unsigned int ix=(x>0 ? (x<65535 ? (unsigned int)x : 65535) : 0);
+  unsigned int iz=(z>0 ? (z<65535 ? (unsigned int)z : 65535) : 0);
+  return SpreadBits(ix)|(SpreadBits(iz)<<1);
+}
+
+// Average distance between organisms one after another in the store
+static double StoreGap(OrganismStoreClass *orgstore) {
+  double sum=0;
+  int i,n=orgstore->Size();
+  if(n<2) return 0;
+  for(i=1;i<n;i++) {
+    VectorClass d=orgstore->Get(i)->Pos()-orgstore->Get(i-1)->Pos();
+    sum+=sqrt(d.X()*d.X()+d.Z()*d.Z());
+  }
+  return sum/(n-1);
+}
+
+static void DropFlashes(stack<EventStack,vector<EventStack> > &s) {
+  while(!s.empty())
+    s.pop();
+}
+
+// Fills in the heading and color of everything left in olist
+static void Describe(OrganismClass *o,vector<OList> &olist) {
+  int i;
+  for(i=0;i<(signed int)olist.size();i++) {
+    olist[i].heading = olist[i].distv;
+    olist[i].heading-=o->Heading();
+    olist[i].color = olist[i].seen->Color();
+  }
+}
+
 
 
 UniverseClass::UniverseClass(int argc, char **argv) {
+  // CheckKeys() only ever flips these afterwards, and -m never calls it
   done = 0;
-  ogl = new OpenGLClass(argc,argv);
+  pause = 0;
+  drift = tick_step = 0;
+  tick_swaps = period_swaps = most_swaps = 0;
+  tick_pairs = period_pairs = 0;
+  list_builds = list_uses = 0;
+  senses_width = 0;
+  soak_ticks = soak_peak = soak_sum = soak_samples = soak_born = 0;
+  soak_allocs = 0;
+  soak_pop = soak_pop2 = 0;
+  soak_start = 0;
+  ticks = reorders = period_reorders = sensed = 0;
+  reorder_time = sense_time = 0;
+  gap_before = gap_after = 0;
+  think_time = 0;
+  thought = think_groups = 0;
+  // -m runs headless: no window, and SDL isn't even started, so it
+  // works where there is no display
+  ogl = (SOAK_TICKS ? NULL : new OpenGLClass(argc,argv));
   world = new WorldClass(argc,argv);
-  orglist = new OrganismListClass;
+  orgstore = new OrganismStoreClass;
   idserver = new IdServerClass;
+  next_seq = 0;
+  // the index spans the same floor that WorldClass::ChangePosition
+  // keeps organisms on
+  index = NewSpatialIndex(SPATIAL_INDEX,
+			  (-FLOOR_BLOCKS_X/2-1)*FLOOR_QUAD_SIZE,
+			  (-FLOOR_BLOCKS_Z/2-1)*FLOOR_QUAD_SIZE,
+			  (FLOOR_BLOCKS_X/2)*FLOOR_QUAD_SIZE,
+			  (FLOOR_BLOCKS_Z/2)*FLOOR_QUAD_SIZE,
+			  GRID_CELL_SIZE);
+  food = new FoodStoreClass(SPATIAL_INDEX,
+			    (-FLOOR_BLOCKS_X/2-1)*FLOOR_QUAD_SIZE,
+			    (-FLOOR_BLOCKS_Z/2-1)*FLOOR_QUAD_SIZE,
+			    (FLOOR_BLOCKS_X/2)*FLOOR_QUAD_SIZE,
+			    (FLOOR_BLOCKS_Z/2)*FLOOR_QUAD_SIZE,
+			    GRID_CELL_SIZE);
 }
 
 
 UniverseClass::~UniverseClass() {
-  delete ogl;
+  Bury();
+  if(ogl) delete ogl;
   delete world;
-  delete orglist;
+  delete orgstore;
   delete idserver;
+  delete index;
+  delete food;
 }
 
 
@@ -107,11 +244,6 @@ bool UniverseClass::MainLoop() {
   OrganismClass *o;
   int i;
 
-  IdToken *token;
-  VectorClass *pos;
-  AngleClass *heading;
-  GeneClass *genes;
-
   /*
    * This section creates the initial organisms and food
    */
@@ -123,30 +255,30 @@ bool UniverseClass::MainLoop() {
 
   for(i=0;i<NUM_ORGANISMS + NUM_FOOD;i++) {
     // Each Organism is represented by a unique Id
-    token = idserver->GetToken();
+    IdToken token = idserver->GetToken();
     
     // Get a random position in the world
-    pos = world->NewPosition();
+    VectorClass pos = world->NewPosition();
 
     // Choose 0 degrees as the initial direction
-    heading = new AngleClass(0);
+    AngleClass heading(0);
 
     // Stir up some new genes!
-    genes = new GeneClass;
+    GeneClass genes;
 
     // Throw it all in the pot and cook up an organism
     o = new OrganismClass(token,pos,heading,genes);
 
-    // Put it on the list to keep track of it
-    orglist->Append(o);
-
     // If we've created all the organisms, do food instead
     if(i>=NUM_ORGANISMS) {
       o->Type(ORGANISM_FOOD); // Make it into food instead!
+      Add(o);
 #if DEBUG_OUTPUT
       printf("[INIT] Created food organism #%d\n", i - NUM_ORGANISMS + 1);
 #endif
     } else {
+      // Put it on the list to keep track of it
+      Add(o);
       // otherwise give it full energy to start
       o->Energy().EatFood(o->Energy().FoodCap());
 #if DEBUG_OUTPUT
@@ -168,12 +300,49 @@ bool UniverseClass::MainLoop() {
     Update();
 
     frames++;
+    if(SOAK_TICKS) Soak();
 
     cur_time=time(NULL);
     if(cur_time-start_time >= 5) {
 #if DEBUG_OUTPUT
       printf("Frames per second: %f\n", double(double(frames)/double(cur_time-start_time)));
+      // with -m the counts go back to the start of the run
+      long period_ticks=(SOAK_TICKS ? soak_ticks : frames);
+      if(NEIGHBOR_SKIN>0)
+	printf("Neighbor lists: %ld rebuilt out of %ld used (skin %.2f)\n",
+	       list_builds, list_uses, NEIGHBOR_SKIN);
+      printf("Vision repair: %.1f swaps per tick, %ld at most\n",
+	     double(period_swaps)/period_ticks, most_swaps);
+      printf("Contact pairs: %.1f per tick\n",double(period_pairs)/period_ticks);
+      printf("Brains: %ld reused, %ld made, %d spare\n",
+	     brainpool.Reused(),brainpool.Made(),brainpool.Size());
+      long dense,gathered;
+      CountDense(orgstore,dense,gathered);
+      printf("Neurodes: %ld dense, %ld gathered\n",dense,gathered);
+      if(period_reorders)
+	printf("Reordering: %ld times, %.1f us each, next in the store %.2f apart before, %.2f after\n",
+	       period_reorders,1e6*reorder_time/CLOCKS_PER_SEC/period_reorders,
+	       gap_before/period_reorders,gap_after/period_reorders);
+      if(sensed)
+	printf("Sensing: %.2f us per organism\n",1e6*sense_time/CLOCKS_PER_SEC/sensed);
+      if(think_groups)
+	printf("Thinking: %.2f us per brain, %.1f brains of each shape\n",
+	       1e6*think_time/CLOCKS_PER_SEC/thought,double(thought)/think_groups);
 #endif
+      // with -m these add up over the whole run, for Soak()
+      if(!SOAK_TICKS) {
+	reorder_time=sense_time=think_time=0;
+	period_reorders=sensed=thought=think_groups=0;
+	gap_before=gap_after=0;
+	list_builds=list_uses=0;
+	period_swaps=most_swaps=0;
+	period_pairs=0;
+      }
+      if(BENCHMARK) {
+	Benchmark();
+	BirthBenchmark();
+	BrainBenchmark();
+      }
       start_time=cur_time;
       frames=0;
     }
@@ -183,37 +352,45 @@ bool UniverseClass::MainLoop() {
 
 
 bool UniverseClass::Update() {
-  orglist->Rewind();
-
   OrganismClass *o;
-  vector<OrganismClass *> foodlist,livelist;
-  IdToken *token;
-  VectorClass *pos;
-  AngleClass *heading;
-  GeneClass *genes;
+  vector<OrganismClass *> &livelist=turns,&dead=aged;
+  int i;
 
   if(!pause) {
-  while((o=orglist->Next())) { 
+  Bury();
+  livelist.clear();
+  dead.clear();
+  tick_step = 0;
+
+  // Going backwards, since removing one moves the last one into its place
+  for(i=orgstore->Size()-1;i>=0;i--) {
+    o=orgstore->Get(i);
 
     // If the Organism has gone off to never-never land
     if(isnan(o->Pos().X()) || isnan(o->Pos().Z())) {
-      orglist->Remove(o->Id()); // get rid of it
+      orgstore->Remove(o->Handle()); // get rid of it
+      index->Remove(o);
+      Discard(o);
       continue;
     }
 
 
     if(o->Type()==ORGANISM_LIVE) livelist.push_back(o);
-    
-    if(o->Type()==ORGANISM_FOOD) {
-      // Check food lifespan before calling Lifetick to show remaining time
-      // Note: We can't easily access lifespan from here, so we'll log after decay
-      if(!o->Lifetick()) { // check if food has decayed
+  }
+  // everybody takes their turn in the order they came into the world
+  sort(livelist.begin(),livelist.end(),SeqBefore);
+  if(REORDER_TICKS>0 && ticks%REORDER_TICKS==0) Reorder();
+  ticks++;
+
+  // Going backwards, since removing food moves the last one into its place
+  for(i=food->Size()-1;i>=0;i--) {
+    // Check food lifespan before calling Lifetick to show remaining time
+    // Note: We can't easily access lifespan from here, so we'll log after decay
+    if(!food->Get(i)->Lifetick()) { // check if food has decayed
 #if DEBUG_OUTPUT
-	printf("Decay! (food item expired after %d ticks, removed from world)\n", DECAY_SPAN);
+      printf("Decay! (food item expired after %d ticks, removed from world)\n", DECAY_SPAN);
 #endif
-	orglist->Remove(o->Id());
-      } else
-	foodlist.push_back(o);
+      Discard(food->Remove(i));
     }
   }
 
@@ -227,139 +404,216 @@ bool UniverseClass::Update() {
            (int)livelist.size(), NUM_ORGANISMS);
     printf("New guy!\n");
 #endif
-    token = idserver->GetToken();
-    pos = world->NewPosition();
-    heading = new AngleClass(0);
-    genes = new GeneClass;
+    IdToken token = idserver->GetToken();
+    VectorClass pos = world->NewPosition();
+    AngleClass heading(0);
+    GeneClass genes;
     o = new OrganismClass(token,pos,heading,genes);
-    orglist->Append(o);
+    Add(o);
     o->Energy().EatFood(o->Energy().FoodCap()/2);
   }
 
   // Same as above, but for food instead
   // BUGFIX: Only spawn if NUM_FOOD > 0 (user explicitly wants food)
-  if(NUM_FOOD > 0 && (signed int)foodlist.size() < NUM_FOOD) {
+  if(NUM_FOOD > 0 && food->Size() < NUM_FOOD) {
     // Food was eaten or decayed - respawn to maintain NUM_FOOD count
     // This is expected behavior: system maintains constant food supply
 #if DEBUG_OUTPUT
-    printf("[UPDATE] Spawning new food: foodlist.size()=%d < NUM_FOOD=%d (food was eaten/decayed)\n", 
-           (int)foodlist.size(), NUM_FOOD);
+    printf("[UPDATE] Spawning new food: food->Size()=%d < NUM_FOOD=%d (food was eaten/decayed)\n", 
+           food->Size(), NUM_FOOD);
     cout << "More food!" << endl;
 #endif
-    token = idserver->GetToken();
-    pos = world->NewPosition();
-    heading = new AngleClass(0);
-    genes = new GeneClass;
+    IdToken token = idserver->GetToken();
+    VectorClass pos = world->NewPosition();
+    AngleClass heading(0);
+    GeneClass genes;
     o = new OrganismClass(token,pos,heading,genes);
-    orglist->Append(o);
     o->Type(ORGANISM_FOOD);
-  } else if(NUM_FOOD == 0 && (signed int)foodlist.size() > 0) {
+    Add(o);
+  } else if(NUM_FOOD == 0 && food->Size() > 0) {
     // If user set NUM_FOOD=0 but food exists, log it (shouldn't happen after fix)
 #if DEBUG_OUTPUT
-    printf("[UPDATE] WARNING: NUM_FOOD=0 but foodlist.size()=%d (this should not spawn new food)\n", 
-           (int)foodlist.size());
+    printf("[UPDATE] WARNING: NUM_FOOD=0 but food->Size()=%d (this should not spawn new food)\n", 
+           food->Size());
 #endif
   }
 
-  int i;
+  // Everybody senses the world as it is at the start of the tick
+  Sense(livelist);
+  if(BATCH_BRAINS) Think(livelist);
   for(i=0;i<(signed int)livelist.size();i++) {
-    if(livelist[i]->Type()==ORGANISM_LIVE) {
-      UpdateOrganism(livelist[i],foodlist,livelist.size());
+    if(livelist[i]->Type()==ORGANISM_LIVE)
+      UpdateOrganism(livelist[i],&senses[i*senses_width]);
+  }
 
-      livelist[i]->Lifetick();
-    }
+  // Once everyone has moved, whoever is close enough meets
+  Interact(livelist);
+
+  // Everybody alive ages in one pass over the vitals, then the ones
+  // that died of it are handed over to the food in turn order
+  vitals.Lifetick(dead);
+  sort(dead.begin(),dead.end(),SeqBefore);
+  for(i=0;i<(signed int)dead.size();i++)
+    Kill(dead[i]);
+
+  period_swaps+=tick_swaps;
+  if(tick_swaps>most_swaps) most_swaps=tick_swaps;
+  tick_swaps=0;
+  period_pairs+=tick_pairs;
   }
-  livelist.clear();
-  foodlist.clear();
+
+  if(ogl) UpdateDraw();
+  else {
+    // nothing is drawn, so nothing would ever take the flashes off
+    DropFlashes(fightstack);
+    DropFlashes(matestack);
+    DropFlashes(foodstack);
   }
 
-  UpdateDraw();
+  return true;
+}
 
+// Sorts the store by MortonKey(), so that organisms that are near
+// each other in the world are near each other in the store, and
+// walking the store walks across the world instead of all over it
+bool UniverseClass::Reorder() {
+  int i,n=orgstore->Size();
+  clock_t t0=clock();
+
+  reorder_keys.resize(n);
+  for(i=0;i<n;i++)
+    reorder_keys[i]=MortonKey(orgstore->Get(i));
+  gap_before+=StoreGap(orgstore);
+  orgstore->Reorder(reorder_keys);
+  gap_after+=StoreGap(orgstore);
+
+  reorder_time+=clock()-t0;
+  reorders++;
+  period_reorders++;
   return true;
 }
 
-bool UniverseClass::UpdateOrganism(OrganismClass *o,vector<OrganismClass *> foodlist,int org_count) {
-  int i;
-  vector<float> inputs,outputs;
-  OrganismClass *tmp,*mate=NULL;
+// Works out what every organism on livelist senses this tick, before
+// any of them get to act on it.  Row i of senses (senses_width floats
+// long, the most inputs any of them has) holds livelist[i]'s inputs.
+// Sensing only changes the organism's own lists, so they go in the
+// order of the store, where neighbors follow each other (see
+// Reorder()) and share what is in the cache.  The random first input
+// is drawn in turn order beforehand, so the order doesn't matter.
+bool UniverseClass::Sense(vector<OrganismClass *> &livelist) {
+  int i,j;
+  clock_t t0=clock();
+  senses_width=0;
+  for(i=0;i<(signed int)livelist.size();i++) {
+    if(livelist[i]->Brain().NumInputs()>senses_width)
+      senses_width=livelist[i]->Brain().NumInputs();
+  }
+  if(senses.size()<livelist.size()*senses_width)
+    senses.resize(livelist.size()*senses_width);
+  sense_order.assign(orgstore->Size(),-1);
+  for(i=0;i<(signed int)livelist.size();i++) {
+    senses[i*senses_width]=float(rand())/RAND_MAX*2.0-1.0;
+    sense_order[orgstore->Index(livelist[i]->Handle())]=i;
+  }
+  for(j=0;j<(signed int)sense_order.size();j++) {
+    i=sense_order[j];
+    if(i>=0) Sense(livelist[i],&senses[i*senses_width]);
+  }
+  sense_time+=clock()-t0;
+  sensed+=livelist.size();
+  return true;
+}
+
+// Everybody thinks, and learns, on what they sensed, before any of
+// them act.  Nobody's brain depends on anyone else's, so this comes
+// out the same as each of them thinking on their turn, but brains of
+// the same shape can go together through NeuralNet::RunBatch().
+bool UniverseClass::Think(vector<OrganismClass *> &livelist) {
+  int i,j,n=livelist.size();
+  clock_t t0=clock();
+
+  for(i=0;i<n;i++)
+    livelist[i]->Brain().SetInputs(&senses[i*senses_width]);
+  thinkers=livelist;
+  sort(thinkers.begin(),thinkers.end(),ShapeBefore);
+  think_nets.resize(n);
+  think_lc.resize(n);
+  for(i=0;i<n;i++) {
+    think_nets[i]=&thinkers[i]->Brain();
+    think_lc[i]=thinkers[i]->Genes().LC();
+  }
+  for(i=0;i<n;i=j) {
+    for(j=i+1;j<n && SameShape(*think_nets[i],*think_nets[j]);j++) ;
+    NeuralNet::RunBatch(&think_nets[i],j-i,&think_lc[i],ALPHA_COEFFICIENT,
+			FUSED_LEARNING);
+    think_groups++;
+  }
+  think_time+=clock()-t0;
+  thought+=n;
+  return true;
+}
+
+// Fills in the first o->Brain().NumInputs() floats of row, after the
+// random one Sense(livelist) has already put first
+bool UniverseClass::Sense(OrganismClass *o,float *row) {
+  int i,n=1;
+  int num_in=o->Brain().NumInputs();
 #ifdef OLD_LOOP
+  OrganismClass *tmp;
   float last_min=0,min_limit=0,dist=0;
-#endif
-  VectorClass distv,dims;
+  VectorClass distv;
   ColorClass color;
   AngleClass heading;
+#endif
   
   // Start by giving some inputs to the neural network
-  inputs.push_back(float(rand())/RAND_MAX*2.0-1.0);
-  inputs.push_back(o->Energy().Health());
-  inputs.push_back(o->Energy().Food());
+  row[n++]=o->Energy().Health();
+  row[n++]=o->Energy().Food();
 
 
 #ifndef OLD_LOOP
   // alternative to below
 
-  orglist->Rewind();
-  vector<OList> olist;
+  vector<OList> &olist=sight;
   VectorClass headingvect=o->Heading().Vector();
-  while((tmp=orglist->Next())) {
-    OList ol;
-    if(tmp!=o) {
-      ol.distv = (tmp->Pos() - o->Pos());
-      if(ol.distv.Dot(headingvect) > 0) {
-	ol.dist = ol.distv.Magnitude();
-	ol.color = tmp->Color();
-	ol.heading = ol.distv;
-	ol.heading-=o->Heading();
-	olist.push_back(ol);
-      }
-    }
-  }
+  // each organism seen takes up 5 inputs, after the first 3
+  int max_seen=(num_in-4)/5;
+  Look(o,headingvect,max_seen,true,olist);
+  Describe(o,olist);
   long reallen = olist.size();
-  QuickSortOList(olist);
   i=0;
-  while(i<reallen && (signed int)(inputs.size()+5) < o->Brain().NumInputs()) {
-    inputs.push_back((float)olist[i].dist);
-    inputs.push_back((float)olist[i].heading.Angle());
-    inputs.push_back((float)olist[i].color.R());
-    inputs.push_back((float)olist[i].color.G());
-    inputs.push_back((float)olist[i].color.B());
+  while(i<reallen && n+5 < num_in) {
+    row[n++]=(float)olist[i].dist;
+    row[n++]=(float)olist[i].heading.Angle();
+    row[n++]=(float)olist[i].color.R();
+    row[n++]=(float)olist[i].color.G();
+    row[n++]=(float)olist[i].color.B();
     i++;
   }
 
   // FOOD VISION: Allow organisms to see food items (yellow objects)
   // This enables foraging behavior to evolve
   // Follows same pattern as organism vision above
-  vector<OList> foodvision;
-  VectorClass food_headingvect = o->Heading().Vector(); // Reuse heading vector
+  vector<OList> &foodvision=foodsight;
   int food_idx;
-  for(food_idx=0; food_idx < (signed int)foodlist.size(); food_idx++) {
-    // Safety check: ensure food item exists and is actually food
-    if(foodlist[food_idx] && foodlist[food_idx]->Type() == ORGANISM_FOOD) {
-      OList food_ol;
-      food_ol.distv = (foodlist[food_idx]->Pos() - o->Pos());
-      
-      // Field of view check: only see food in front of organism
-      // Same dot product test as organism vision
-      if(food_ol.distv.Dot(food_headingvect) > 0) {
-	food_ol.dist = food_ol.distv.Magnitude();
-	
-	// Food is always yellow: R=1.0, G=1.0, B=0.0
-	// This is how organisms learn to identify food
-	food_ol.color.R(1.0);
-	food_ol.color.G(1.0);
-	food_ol.color.B(0.0);
-	
-	// Calculate heading angle relative to organism's current heading
-	food_ol.heading = food_ol.distv;
-	food_ol.heading -= o->Heading();
-	
-	foodvision.push_back(food_ol);
-      }
-    }
-  }
   
-  // Sort food by distance (closest first) - prioritizes nearby food
-  QuickSortOList(foodvision);
+  // Keep only as much food as there are inputs left for, closest first
+  // - prioritizes nearby food
+  // Field of view check: only see food in front of organism
+  // Same test as organism vision
+  Look(o,headingvect,(num_in-n-1)/5,false,foodvision);
+
+  for(food_idx=0; food_idx < (signed int)foodvision.size(); food_idx++) {
+    // Food is always yellow: R=1.0, G=1.0, B=0.0
+    // This is how organisms learn to identify food
+    foodvision[food_idx].color.R(1.0);
+    foodvision[food_idx].color.G(1.0);
+    foodvision[food_idx].color.B(0.0);
+
+    // Calculate heading angle relative to organism's current heading
+    foodvision[food_idx].heading = foodvision[food_idx].distv;
+    foodvision[food_idx].heading -= o->Heading();
+  }
   
   // Feed food vision data to neural network inputs
   // Same pattern as organism vision: 5 values per food (distance, angle, R, G, B)
@@ -375,12 +629,12 @@ bool UniverseClass::UpdateOrganism(OrganismClass *o,vector<OrganismClass *> food
   }
 #endif
   
-  while(food_i < food_reallen && (signed int)(inputs.size()+5) < o->Brain().NumInputs()) {
-    inputs.push_back((float)foodvision[food_i].dist);
-    inputs.push_back((float)foodvision[food_i].heading.Angle());
-    inputs.push_back((float)foodvision[food_i].color.R()); // Should be 1.0
-    inputs.push_back((float)foodvision[food_i].color.G()); // Should be 1.0
-    inputs.push_back((float)foodvision[food_i].color.B()); // Should be 0.0
+  while(food_i < food_reallen && n+5 < num_in) {
+    row[n++]=(float)foodvision[food_i].dist;
+    row[n++]=(float)foodvision[food_i].heading.Angle();
+    row[n++]=(float)foodvision[food_i].color.R(); // Should be 1.0
+    row[n++]=(float)foodvision[food_i].color.G(); // Should be 1.0
+    row[n++]=(float)foodvision[food_i].color.B(); // Should be 0.0
     food_i++;
   }
 
@@ -391,12 +645,12 @@ bool UniverseClass::UpdateOrganism(OrganismClass *o,vector<OrganismClass *> food
   // (note: this _needs_ optimizing!)
   // (note: the above code optimizes this, this will be removed soon)
 
-  while((signed int)(inputs.size() + 5) < o->Brain().NumInputs()) {
+  while(n + 5 < num_in) {
     color.R(0); color.G(0); color.B(0);
     heading=0;
     last_min=0;
-    orglist->Rewind();
-    while((tmp=orglist->Next())) {
+    for(i=0;i<orgstore->Size();i++) {
+      tmp=orgstore->Get(i);
       if(tmp == o) continue;
       distv=(tmp->Pos() - o->Pos());
       dist=distv.Magnitude();
@@ -409,42 +663,58 @@ bool UniverseClass::UpdateOrganism(OrganismClass *o,vector<OrganismClass *> food
       }
     }
     min_limit=(last_min>min_limit ? last_min : min_limit);
-    inputs.push_back((float)last_min);
-    inputs.push_back((float)heading.Angle());
-    inputs.push_back((float)color.R());
-    inputs.push_back((float)color.G());
-    inputs.push_back((float)color.B());
+    row[n++]=(float)last_min;
+    row[n++]=(float)heading.Angle();
+    row[n++]=(float)color.R();
+    row[n++]=(float)color.G();
+    row[n++]=(float)color.B();
   }
 #endif
 
   // Any inputs left over? fill em with 0
 #ifndef OLD_LOOP
-  while((signed int)inputs.size() < o->Brain().NumInputs())
-    inputs.push_back(0);
+  while(n < num_in)
+    row[n++]=0;
 #else
-  while((signed int)inputs.size()<o->Brain().NumInputs()) inputs.push_back(float(rand())/RAND_MAX*2.0-1.0);
+  while(n < num_in) row[n++]=float(rand())/RAND_MAX*2.0-1.0;
 #endif
 
 #ifdef _NN_DEBUG
 #if DEBUG_OUTPUT
-  printf("Num Inputs: %d\n",inputs.size());
-  for(i=0;i<(signed int)inputs.size();i++) 
-    printf("%f ",inputs[i]);
+  printf("Num Inputs: %d\n",num_in);
+  for(i=0;i<num_in;i++) 
+    printf("%f ",row[i]);
   printf("\n");
   getchar();
 #endif
 #endif
 
+  return true;
+}
 
-  o->Brain().SetInputs(inputs);
+// Thinks and acts on what o sensed this tick, row is its row of senses
+bool UniverseClass::UpdateOrganism(OrganismClass *o,float *row) {
+  VectorClass distv;
 
-  o->Brain().RunNet();
+  // without -t nobody has thought yet (see Think())
+  if(!BATCH_BRAINS) {
+    o->Brain().SetInputs(row);
+
+    // learning doesn't change what the brain just put out, so it can
+    // be done in the same pass
+    if(FUSED_LEARNING)
+      o->Brain().RunAndLearn(o->Genes().LC(),ALPHA_COEFFICIENT);
+    else
+      o->Brain().RunNet();
+  }
 
+  outputs.clear();
   o->Brain().GetOutputs(outputs);
 
 #ifdef _NN_DEBUG
 #if DEBUG_OUTPUT
-  printf("Num Outputs: %d\n",inputs.size());
+  int i;
+  printf("Num Outputs: %d\n",outputs.size());
   for(i=0;i<(signed int)outputs.size();i++) 
     printf("%f ",outputs[i]);
   printf("\n");
@@ -452,7 +722,8 @@ bool UniverseClass::UpdateOrganism(OrganismClass *o,vector<OrganismClass *> food
 #endif
 #endif
 
-  o->Brain().Learn(o->Genes().LC(),ALPHA_COEFFICIENT);
+  if(!BATCH_BRAINS && !FUSED_LEARNING)
+    o->Brain().Learn(o->Genes().LC(),ALPHA_COEFFICIENT);
 
   // Change the heading according to the output of the neural network
   o->Heading()+=double(((int)outputs[1] % 20)/10 * (double)o->Genes().MaxSpeed());
@@ -465,7 +736,17 @@ bool UniverseClass::UpdateOrganism(OrganismClass *o,vector<OrganismClass *> food
 #endif
 
   // ditto for the position
+  VectorClass oldpos=o->Pos();
   world->ChangePosition(o->Pos(),dir);
+  index->Move(o,oldpos);
+  // keep track of the farthest anything has gone this tick, for the
+  // neighbor lists
+  double step=abs_d(o->Pos().X()-oldpos.X());
+  if(abs_d(o->Pos().Z()-oldpos.Z())>step) step=abs_d(o->Pos().Z()-oldpos.Z());
+  if(step>tick_step) {
+    drift+=step-tick_step;
+    tick_step=step;
+  }
 
 
   // Set the Aggressive coloration (Red channel)
@@ -494,125 +775,606 @@ bool UniverseClass::UpdateOrganism(OrganismClass *o,vector<OrganismClass *> food
   
   // Find out if this organism is near to any food, and whether or not
   // it needs that food
-  for(i=0;i<(signed int)foodlist.size();i++) {
-    if(o->Energy().Food() != o->Energy().FoodCap()) {  
-      if(foodlist[i]) {
-	distv=foodlist[i]->Pos() - o->Pos();
-	long bounds = o->Genes().Reach();
-	double actual_dist_x = abs_d(distv.X());
-	double actual_dist_z = abs_d(distv.Z());
-	distv.X(actual_dist_x - bounds - o->Size().X());
-	distv.Z(actual_dist_z - bounds - o->Size().Z());
-	if(distv.X() <= 0 && distv.Z() <= 0) {
-	  double amt_food=(1-double(bounds/MAX_REACH)) * foodlist[i]->Energy().HealthCap() * (1+o->Genes().Metabolism());
+  if(o->Energy().Food() != o->Energy().FoodCap()) {  
+    long bounds = o->Genes().Reach();
+    int f=food->First(o->Pos(),bounds+o->Size().X(),bounds+o->Size().Z());
+    if(f>=0) {
+      OrganismClass *meal=food->Get(f);
+      double amt_food=(1-double(bounds/MAX_REACH)) * meal->Energy().HealthCap() * (1+o->Genes().Metabolism());
 #ifdef _DEBUG_FOOD
 #if DEBUG_OUTPUT
-	  printf("Food Eaten: %f (distance: X=%.2f, Z=%.2f, reach=%ld, size=%.2f)\n",
-		 amt_food, actual_dist_x, actual_dist_z, bounds, o->Size().X());
-#endif
-#endif
-	  EventStack es;
-	  es.a = o->Pos();
-	  es.b = foodlist[i]->Pos();
-	  es.a.Y(o->Size().Y()/2);
-	  es.b.Y(foodlist[i]->Size().Y()/2);
-	  es.color.R(1);
-	  es.color.G(1);
-	  es.color.B(0);
-	  es.frames_remaining = EVENT_FLASH_DURATION;
-	  foodstack.push(es);
-	  o->Energy().EatFood(amt_food);
+      distv=meal->Pos() - o->Pos();
+      double actual_dist_x = abs_d(distv.X());
+      double actual_dist_z = abs_d(distv.Z());
+      printf("Food Eaten: %f (distance: X=%.2f, Z=%.2f, reach=%ld, size=%.2f)\n",
+	     amt_food, actual_dist_x, actual_dist_z, bounds, o->Size().X());
+#endif
+#endif
+      EventStack es;
+      es.a = o->Pos();
+      es.b = meal->Pos();
+      es.a.Y(o->Size().Y()/2);
+      es.b.Y(meal->Size().Y()/2);
+      es.color.R(1);
+      es.color.G(1);
+      es.color.B(0);
+      es.frames_remaining = EVENT_FLASH_DURATION;
+      foodstack.push(es);
+      o->Energy().EatFood(amt_food);
 #if DEBUG_OUTPUT
-	  printf("Eat! (food amount: %.2f, new energy: %.2f/%.2f)\n", 
-		 amt_food, o->Energy().Food(), o->Energy().FoodCap());
+      printf("Eat! (food amount: %.2f, new energy: %.2f/%.2f)\n", 
+	     amt_food, o->Energy().Food(), o->Energy().FoodCap());
 #endif
-	  orglist->Remove(foodlist[i]->Id());
-	  foodlist[i]=NULL;
-	  break;
-	}
+      Discard(food->Remove(f)); // gone for good
+    }
+  }
+
+
+
+#ifdef _DEBUG
+  printf("%f\n",(double)o->Genes().MaxSpeed());
+#endif
+
+  
+  return true;
+}
+
+// Finds every pair of live organisms where at least one can reach the
+// other, looking at each pair only once, and puts them on contacts
+// once for each way the reach goes.  contacts ends up sorted by who
+// reaches, then by who is reached, in the order they came into the
+// world.  Returns how many pairs there were.
+int UniverseClass::FindContacts(vector<OrganismClass *> &livelist) {
+  vector<IndexEntry> *src;
+  ContactPair c;
+  OrganismClass *a,*b;
+  double ax,az,bx,bz,dx,dz;
+  int i,j,pairs=0;
+
+  contacts.clear();
+  if(!USE_GRID) {
+    IndexEntry e;
+    everyone.clear();
+    for(i=0;i<orgstore->Size();i++) {
+      e.o=orgstore->Get(i);
+      e.seq=e.o->Seq();
+      everyone.push_back(e);
+    }
+  }
+
+  for(i=0;i<(signed int)livelist.size();i++) {
+    a=livelist[i];
+    if(a->Type()!=ORGANISM_LIVE) continue;
+    ax=a->Size().X()+a->Genes().Reach();
+    az=a->Size().Z()+a->Genes().Reach();
+
+    // nobody reaches farther than CONTACT_RANGE.  Without the grid
+    // everyone is a candidate, and is looked at where it is.
+    src=&contact_cand;
+    if(!USE_GRID)
+      src=&everyone;
+    else if(NEIGHBOR_SKIN>0 && Neighbors(a)>=CONTACT_RANGE) {
+      NeighborListClass &n=a->Neighbors();
+      contact_cand.clear();
+      for(j=0;j<n.Size();j++)
+	contact_cand.push_back(n.Entry(j));
+    } else {
+      contact_cand.clear();
+      index->QueryEntries(a->Pos(),CONTACT_RANGE,CONTACT_RANGE,contact_cand);
+    }
+    vector<IndexEntry> &cand=*src;
+
+    for(j=0;j<(signed int)cand.size();j++) {
+      b=cand[j].o;
+      // the other one of the pair finds it from its side
+      if(cand[j].seq<=a->Seq() || b->Type()!=ORGANISM_LIVE) continue;
+      dx=abs_d(b->Pos().X()-a->Pos().X());
+      dz=abs_d(b->Pos().Z()-a->Pos().Z());
+      bx=b->Size().X()+b->Genes().Reach();
+      bz=b->Size().Z()+b->Genes().Reach();
+      bool a_reaches=(dx<=ax && dz<=az),b_reaches=(dx<=bx && dz<=bz);
+      if(!a_reaches && !b_reaches) continue;
+      pairs++;
+      if(a_reaches) {
+	c.a=a; c.b=b; c.a_seq=a->Seq(); c.b_seq=cand[j].seq;
+	contacts.push_back(c);
       }
-    } else break;
+      if(b_reaches) {
+	c.a=b; c.b=a; c.a_seq=cand[j].seq; c.b_seq=a->Seq();
+	contacts.push_back(c);
+      }
+    }
   }
+  sort(contacts.begin(),contacts.end(),ContactBefore);
+  return pairs;
+}
 
+// Every live organism meets the first one (in the order they came in)
+// that it can reach and that is still alive
+bool UniverseClass::Interact(vector<OrganismClass *> &livelist) {
+  OrganismClass *o,*mate;
+  long born=next_seq;
+  int i,j=0;
 
+  tick_pairs=FindContacts(livelist);
+  for(i=0;i<(signed int)livelist.size();i++) {
+    o=livelist[i];
+    while(j<(signed int)contacts.size() && contacts[j].a_seq<o->Seq()) j++;
+    mate=NULL;
+    for(;j<(signed int)contacts.size() && contacts[j].a==o;j++) {
+      if(!mate && contacts[j].b->Type()==ORGANISM_LIVE)
+	mate=contacts[j].b;
+    }
+    if(o->Type()!=ORGANISM_LIVE) continue;
+    if(CHECK_GRID) {
+      // organisms born during this pass aren't in it
+      OrganismClass *check=Contact(o);
+      if(check && check->Seq()>=born) check=NULL;
+      if(check!=mate)
+	fprintf(stderr,"[GRID_CHECK] Contact pass found a different organism within reach\n");
+    }
+    if(mate) Meet(o,mate,livelist.size());
+  }
+  return true;
+}
 
-  orglist->Rewind();
-  // Find if there are any Organisms nearby this one
-  while((mate=orglist->Next())) {
-    if(mate==o) continue; // if its the same one
-    distv = mate->Pos() - o->Pos(); // get the vector between them
-    distv.X(abs_d(distv.X())-o->Size().X()-o->Genes().Reach());
-    distv.Z(abs_d(distv.Z())-o->Size().Z()-o->Genes().Reach());
+// o has found mate within reach, now they decide whether to fight
+// or mate
+bool UniverseClass::Meet(OrganismClass *o,OrganismClass *mate,int org_count) {
+  outputs.clear();
+  mate_outputs.clear();
+  o->Brain().GetOutputs(outputs);
+  mate->Brain().GetOutputs(mate_outputs);
+  // Fight or mate, they decide!
 #ifdef _DEBUG
-    char s[30];
-    o->Id().String(s);
 #if DEBUG_OUTPUT
-    printf("%s: %f %f %f\n",s,distv.X(),distv.Y(),distv.Z());
+  cout << "Fight: " << outputs[3] << " " << mate_outputs[3] << endl;
+  cout << "Mate: " << outputs[2] << " " << mate_outputs[2] << endl;
 #endif
 #endif
-    if(distv.X() <= 0 &&  distv.Z() <= 0) { // if close enough
-      vector<float> mate_outputs;
-      mate->Brain().GetOutputs(mate_outputs);
-      // Fight or mate, they decide!
-#ifdef _DEBUG
-#if DEBUG_OUTPUT
-      cout << "Fight: " << outputs[3] << " " << mate_outputs[3] << endl;
-      cout << "Mate: " << outputs[2] << " " << mate_outputs[2] << endl;
-#endif
-#endif
-      // Fight condition: product of both organisms' fight outputs must exceed threshold
-      // Threshold scales with population: more organisms = easier to fight
-      double fight_threshold = FIGHT_THRESHOLD * FIGHT_THRESHOLD * NUM_ORGANISMS / org_count;
-      double fight_product = abs_f(mate_outputs[3]) * abs_f(outputs[3]);
-      
-      // Always log when organisms are close enough to potentially fight/mate
-      // This helps debug why fights aren't happening
-      static int proximity_count = 0;
-      proximity_count++;
-      if(proximity_count % 20 == 0) {  // Log more frequently
+  // Fight condition: product of both organisms' fight outputs must exceed threshold
+  // Threshold scales with population: more organisms = easier to fight
+  double fight_threshold = FIGHT_THRESHOLD * FIGHT_THRESHOLD * NUM_ORGANISMS / org_count;
+  double fight_product = abs_f(mate_outputs[3]) * abs_f(outputs[3]);
+    
+  // Always log when organisms are close enough to potentially fight/mate
+  // This helps debug why fights aren't happening
+  static int proximity_count = 0;
+  proximity_count++;
+  if(proximity_count % 20 == 0) {  // Log more frequently
 #if DEBUG_OUTPUT
-	printf("[PROXIMITY] Organisms close! fight_outputs[3]=%.2f, mate_outputs[3]=%.2f, product=%.2f, threshold=%.2f (NUM_ORGS=%d, org_count=%d)\n",
-	       outputs[3], mate_outputs[3], fight_product, fight_threshold, NUM_ORGANISMS, org_count);
-	printf("[PROXIMITY]   -> Fight would need: product > %.2f (currently %.2f)\n", fight_threshold, fight_product);
-	printf("[PROXIMITY]   -> Mate outputs: %.2f x %.2f = %.2f\n", outputs[2], mate_outputs[2], abs_f(outputs[2]) * abs_f(mate_outputs[2]));
+    printf("[PROXIMITY] Organisms close! fight_outputs[3]=%.2f, mate_outputs[3]=%.2f, product=%.2f, threshold=%.2f (NUM_ORGS=%d, org_count=%d)\n",
+	   outputs[3], mate_outputs[3], fight_product, fight_threshold, NUM_ORGANISMS, org_count);
+    printf("[PROXIMITY]   -> Fight would need: product > %.2f (currently %.2f)\n", fight_threshold, fight_product);
+    printf("[PROXIMITY]   -> Mate outputs: %.2f x %.2f = %.2f\n", outputs[2], mate_outputs[2], abs_f(outputs[2]) * abs_f(mate_outputs[2]));
 #endif
-      }
-      
-      if(fight_product > fight_threshold) {
-	// Log before attempting fight to see if it succeeds
-	double genetic_variance = o->Genes().Variance(mate->Genes());
-	
-	// Debug: Show actual DNA values to understand why variance is 0
+  }
+    
+  if(fight_product > fight_threshold) {
+    // Log before attempting fight to see if it succeeds
+    double genetic_variance = o->Genes().Variance(mate->Genes());
+
+    // Debug: Show actual DNA values to understand why variance is 0
 #if DEBUG_OUTPUT
-	static int debug_gene_count = 0;
-	if(debug_gene_count++ < 5 && genetic_variance < 0.001) {
-	  // Access DNA directly for debugging (we'll need to add a getter or make DNA public temporarily)
-	  printf("[DEBUG_GENES] Variance=%.4f, showing first 3 genes:\n", genetic_variance);
-	  printf("[DEBUG_GENES]   Gene 0 (SIZE_X): org1=%ld, org2=%ld, diff=%ld\n",
-		 (long)o->Genes().Size().X(), (long)mate->Genes().Size().X(),
-		 (long)(o->Genes().Size().X() - mate->Genes().Size().X()));
-	  printf("[DEBUG_GENES]   Gene 3 (STRENGTH): org1=%.2f, org2=%.2f\n",
-		 o->Genes().GetStrength(), mate->Genes().GetStrength());
-	  printf("[DEBUG_GENES]   Gene 4 (MAXSPEED): org1=%.2f, org2=%.2f\n",
-		 o->Genes().MaxSpeed(), mate->Genes().MaxSpeed());
-	}
-	
-	printf("[FIGHT_ATTEMPT] Product=%.2f > threshold=%.2f, genetic_variance=%.4f (need > %.4f)\n",
-	       fight_product, fight_threshold, genetic_variance, MISCEGENATION_RATE);
+    static int debug_gene_count = 0;
+    if(debug_gene_count++ < 5 && genetic_variance < 0.001) {
+      // Access DNA directly for debugging (we'll need to add a getter or make DNA public temporarily)
+      printf("[DEBUG_GENES] Variance=%.4f, showing first 3 genes:\n", genetic_variance);
+      printf("[DEBUG_GENES]   Gene 0 (SIZE_X): org1=%ld, org2=%ld, diff=%ld\n",
+	     (long)o->Genes().Size().X(), (long)mate->Genes().Size().X(),
+	     (long)(o->Genes().Size().X() - mate->Genes().Size().X()));
+      printf("[DEBUG_GENES]   Gene 3 (STRENGTH): org1=%.2f, org2=%.2f\n",
+	     o->Genes().GetStrength(), mate->Genes().GetStrength());
+      printf("[DEBUG_GENES]   Gene 4 (MAXSPEED): org1=%.2f, org2=%.2f\n",
+	     o->Genes().MaxSpeed(), mate->Genes().MaxSpeed());
+    }
+
+    printf("[FIGHT_ATTEMPT] Product=%.2f > threshold=%.2f, genetic_variance=%.4f (need > %.4f)\n",
+	   fight_product, fight_threshold, genetic_variance, MISCEGENATION_RATE);
 #endif
-	Fight(o,mate);
-      } else if (org_count < NUM_ORGANISMS+2*NUM_FOOD && abs_f(mate_outputs[2]) * abs_f(outputs[2]) > REPRODUCTION_THRESHOLD * org_count/NUM_ORGANISMS) {
-	Mate(o,mate);
+    Fight(o,mate);
+  } else if (org_count < NUM_ORGANISMS+2*NUM_FOOD && abs_f(mate_outputs[2]) * abs_f(outputs[2]) > REPRODUCTION_THRESHOLD * org_count/NUM_ORGANISMS) {
+    Mate(o,mate);
+  }
+  return true;
+}
+
+// Fills olist with the closest max_seen things in front of o, closest
+// first, starting from what o saw last tick.  If orgs is false only
+// food is looked at.  With -c whatever the index saw is checked
+// against looking at the whole world.
+bool UniverseClass::Look(OrganismClass *o,VectorClass &headingvect,int max_seen,bool orgs,vector<OList> &olist) {
+  int i;
+  olist.clear();
+  if(USE_GRID)
+    See(o,headingvect,max_seen,orgs,olist);
+  else
+    SeeAll(o,headingvect,orgs,olist);
+  tick_swaps+=RepairOList(olist,o->Neighbors().Seen(orgs),max_seen,repair);
+  // Only what made it this far needs a real distance
+  for(i=0;i<(signed int)olist.size();i++) {
+    olist[i].distv = (olist[i].seen->Pos() - o->Pos());
+    olist[i].dist = sqrt(olist[i].dist);
+  }
+  if(USE_GRID && CHECK_GRID) {
+    check_sight.clear();
+    SeeAll(o,headingvect,orgs,check_sight);
+    SelectOList(check_sight,max_seen);
+    for(i=0;i<(signed int)check_sight.size();i++)
+      check_sight[i].dist = sqrt(check_sight[i].dist);
+    if(check_sight.size()!=olist.size())
+      fprintf(stderr,"[GRID_CHECK] Grid saw %d, full scan saw %d\n",
+	      (int)olist.size(),(int)check_sight.size());
+    else {
+      for(i=0;i<(signed int)check_sight.size();i++) {
+	if(olist[i].dist!=check_sight[i].dist) {
+	  fprintf(stderr,"[GRID_CHECK] Mismatch at %d: grid %f, full scan %f\n",
+		  i,olist[i].dist,check_sight[i].dist);
+	  break;
+	}
+      }
+    }
+  }
+  return true;
+}
+
+// Finds what o can see using the index and the food store: at least
+// the closest max_seen things in front of it, in no particular order.
+// The search box grows until it holds enough of them, anything found
+// beyond the box's radius could be missing a closer neighbor and is
+// thrown out.  o's neighbor list is tried first, it is only good
+// enough if it has max_seen things within the distance it can be
+// trusted out to.
+bool UniverseClass::See(OrganismClass *o,VectorClass &headingvect,int max_seen,bool orgs,vector<OList> &olist) {
+  vector<OrganismClass *> &near=nearby;
+  double r;
+  double span=world->Size().X()+world->Size().Z()+2*FLOOR_QUAD_SIZE;
+  bool all;
+  int i;
+
+  if(NEIGHBOR_SKIN>0) {
+    r=Neighbors(o);
+    NeighborListClass &n=o->Neighbors();
+    near.clear();
+    for(i=0;i<n.Size();i++) {
+      OrganismClass *tmp=n.Entry(i).o;
+      if(tmp->Type()==ORGANISM_GONE || (!orgs && tmp->Type()!=ORGANISM_FOOD))
+	continue;
+      near.push_back(tmp);
+    }
+    Sight(o,headingvect,near,(r>0 ? r*r : -1),olist);
+    if((signed int)olist.size()>=max_seen) return true;
+  }
+
+  r=index->CellSize();
+
+  do {
+    all = (index->Covers(o->Pos(),r,r) || r > span);
+    near.clear();
+    olist.clear();
+    if(orgs) index->Query(o->Pos(),r,r,near);
+    food->Query(o->Pos(),r,r,near);
+    for(i=0;i<(signed int)near.size();i++) {
+      if(near[i]==o) {
+	near[i]=near.back();
+	near.pop_back();
+	break;
       }
-      break;
     }
-  }  
+    Sight(o,headingvect,near,(all ? HUGE_VAL : r*r),olist);
+    r*=2;
+  } while(!all && (signed int)olist.size()<max_seen);
+
+  return true;
+}
+
+// The original way of seeing: look at everything in the world
+bool UniverseClass::SeeAll(OrganismClass *o,VectorClass &headingvect,bool orgs,vector<OList> &olist) {
+  vector<OrganismClass *> &all=everything;
+  OrganismClass *tmp;
+  int i;
+  all.clear();
+  if(orgs) {
+    for(i=0;i<orgstore->Size();i++) {
+      tmp=orgstore->Get(i);
+      if(tmp!=o)
+	all.push_back(tmp);
+    }
+  }
+  for(i=0;i<food->Size();i++)
+    all.push_back(food->Get(i));
+  Sight(o,headingvect,all,HUGE_VAL,olist);
+  return true;
+}
 
+// Appends everything in cand that is in front of o and no farther
+// than sqrt(max_dist2) away to olist.  The dist put on olist is
+// squared, Look() takes the square root of the few that are kept.
+bool UniverseClass::Sight(OrganismClass *o,VectorClass &headingvect,vector<OrganismClass *> &cand,double max_dist2,vector<OList> &olist) {
+  int i,n=cand.size();
+  OList ol;
+  if(!n) return true;
+  if((signed int)cand_x.size()<n) {
+    cand_x.resize(n);
+    cand_z.resize(n);
+    cand_dist2.resize(n);
+    cand_front.resize(n);
+  }
+  for(i=0;i<n;i++) {
+    cand_x[i]=cand[i]->Pos().X();
+    cand_z[i]=cand[i]->Pos().Z();
+  }
+  SightKernel(o->Pos().X(),o->Pos().Z(),headingvect.X(),headingvect.Z(),
+	      &cand_x[0],&cand_z[0],n,&cand_dist2[0],&cand_front[0]);
+  for(i=0;i<n;i++) {
+    if(cand_front[i] && cand_dist2[i]<=max_dist2) {
+      ol.dist = cand_dist2[i];
+      ol.seen = cand[i];
+      olist.push_back(ol);
+    }
+  }
+  return true;
+}
+
+// Finds the first thing (in the order they came into the world) that
+// o can reach, or NULL if there is nothing within reach
+OrganismClass *UniverseClass::Contact(OrganismClass *o) {
+  double rx=o->Size().X()+o->Genes().Reach();
+  double rz=o->Size().Z()+o->Genes().Reach();
+  OrganismClass *mate=NULL,*tmp;
+  VectorClass distv;
+  int i;
+
+  if(USE_GRID && !CHECK_GRID)
+    return (NEIGHBOR_SKIN>0 ? NearFirst(o,rx,rz) : index->First(o->Pos(),rx,rz,o,NULL));
+
+  for(i=0;i<orgstore->Size();i++) {
+    tmp=orgstore->Get(i);
+    if(tmp==o) continue; // if its the same one
+    if(mate && mate->Seq()<tmp->Seq()) continue;
+    distv = tmp->Pos() - o->Pos(); // get the vector between them
+    distv.X(abs_d(distv.X())-rx);
+    distv.Z(abs_d(distv.Z())-rz);
 #ifdef _DEBUG
-  printf("%f\n",(double)o->Genes().MaxSpeed());
+    char s[30];
+    o->Id().String(s);
+#if DEBUG_OUTPUT
+    printf("%s: %f %f %f\n",s,distv.X(),distv.Y(),distv.Z());
 #endif
+#endif
+    if(distv.X() <= 0 &&  distv.Z() <= 0) // if close enough
+      mate=tmp;
+  }
 
-  
+  if(USE_GRID && index->First(o->Pos(),rx,rz,o,NULL)!=mate)
+    fprintf(stderr,"[GRID_CHECK] Index found a different organism within reach\n");
+  if(USE_GRID && NEIGHBOR_SKIN>0 && NearFirst(o,rx,rz)!=mate)
+    fprintf(stderr,"[GRID_CHECK] Neighbor list found a different organism within reach\n");
+  return mate;
+}
+
+// Same as SpatialIndexClass::First(), but only looks through o's
+// neighbor list.  Falls back on the index if the list can't be
+// trusted that far out.
+OrganismClass *UniverseClass::NearFirst(OrganismClass *o,double rx,double rz) {
+  double r=Neighbors(o);
+  if(!(r>=rx && r>=rz)) return index->First(o->Pos(),rx,rz,o,NULL);
+
+  NeighborListClass &n=o->Neighbors();
+  IndexEntry *best=NULL;
+  int i;
+  for(i=0;i<n.Size();i++) {
+    IndexEntry &e=n.Entry(i);
+    if(e.o->Type()!=ORGANISM_LIVE || (best && best->seq<e.seq)) continue;
+    if(abs_d(e.o->Pos().X()-o->Pos().X())<=rx &&
+       abs_d(e.o->Pos().Z()-o->Pos().Z())<=rz)
+      best=&e;
+  }
+  return (best ? best->o : NULL);
+}
+
+// Rebuilds o's neighbor list when it can't be trusted out to
+// CONTACT_RANGE any more.  Returns how far out it can be trusted.
+double UniverseClass::Neighbors(OrganismClass *o) {
+  NeighborListClass &n=o->Neighbors();
+  double r=n.Trusted(o->Pos(),drift);
+  list_uses++;
+  if(r<CONTACT_RANGE) {
+    // whatever has moved this tick is already where the list sees it,
+    // the rest could still move as far as tick_step
+    n.Build(o,index,food,CONTACT_RANGE+NEIGHBOR_SKIN,drift-tick_step);
+    list_builds++;
+    r=n.Trusted(o->Pos(),drift);
+  }
+  return r;
+}
+
+// Puts o into the world (food or not), and onto the neighbor lists
+// of everything close enough to have it there
+bool UniverseClass::Add(OrganismClass *o) {
+  vector<OrganismClass *> &near=added_near;
+  long seq=-1;
+  int i;
+
+  if(o->Type()==ORGANISM_LIVE) {
+    o->Handle(orgstore->Insert(o));
+    seq=o->Seq(next_seq++);
+    index->Insert(o,seq);
+  } else
+    food->Insert(o);
+
+  if(NEIGHBOR_SKIN>0) {
+    // a list that can still be trusted belongs to an organism no
+    // farther than its radius from where it was built
+    double r=2*(CONTACT_RANGE+NEIGHBOR_SKIN);
+    near.clear();
+    index->Query(o->Pos(),r,r,near);
+    for(i=0;i<(signed int)near.size();i++) {
+      if(near[i]!=o)
+	near[i]->Neighbors().Add(o,seq);
+    }
+  }
+  return true;
+}
+
+// Hands an organism that just died over to the food store.  It is
+// still on the neighbor lists it was on, as food now.
+bool UniverseClass::Kill(OrganismClass *o) {
+  orgstore->Remove(o->Handle());
+  index->Remove(o);
+  o->Neighbors().Clear();
+  food->Insert(o);
+  return true;
+}
+
+// o has already been taken out of the world, it is deleted at the
+// start of the next tick once no neighbor list holds it any more
+bool UniverseClass::Discard(OrganismClass *o) {
+  if(!o) return false;
+  o->Type(ORGANISM_GONE);
+  o->Neighbors().Clear();
+  graveyard.push_back(o);
+  return true;
+}
+
+// Deletes everything that was discarded since the last call
+bool UniverseClass::Bury() {
+  int i;
+  if(graveyard.empty()) return true;
+  for(i=0;i<orgstore->Size();i++)
+    orgstore->Get(i)->Neighbors().Purge();
+  for(i=0;i<(signed int)graveyard.size();i++)
+    delete graveyard[i];
+  graveyard.clear();
+  return true;
+}
+
+// Resident memory in kB, or 0 where /proc/self/statm isn't there
+static long ResidentKB() {
+  FILE *f=fopen("/proc/self/statm","r");
+  long size,resident=0;
+  if(!f) return 0;
+  if(fscanf(f,"%ld %ld",&size,&resident)!=2) resident=0;
+  fclose(f);
+  return resident*(sysconf(_SC_PAGESIZE)/1024);
+}
+
+// Called once a tick with -m.  Every SOAK_SAMPLE ticks it measures
+// resident memory, and after SOAK_TICKS it prints the peak and the
+// steady state (the average over the second half of the run, when
+// the population has long settled) and stops.  It also prints how
+// fast the ticks went and how big the population was and how often
+// organisms were born, so two builds can be held up against each
+// other.
+bool UniverseClass::Soak() {
+  long rss,dense,gathered;
+  double n=orgstore->Size();
+  if(!soak_ticks++) {
+    soak_start=clock();
+    soak_born=next_seq;
+  }
+  soak_pop+=n;
+  soak_pop2+=n*n;
+  if(soak_ticks==SOAK_TICKS/2) soak_allocs=ALLOCATIONS;
+  if(soak_ticks%SOAK_SAMPLE && soak_ticks<SOAK_TICKS) return true;
+
+  rss=ResidentKB();
+  if(rss>soak_peak) soak_peak=rss;
+  if(soak_ticks>SOAK_TICKS/2) {
+    soak_sum+=rss;
+    soak_samples++;
+  }
+  printf("[SOAK] tick %ld: %ld kB resident, %d organisms, %d food, %d vitals rows\n",
+	 soak_ticks,rss,orgstore->Size(),food->Size(),vitals.Size());
+  if(soak_ticks<SOAK_TICKS) return true;
+
+  printf("[SOAK] %ld ticks: peak %ld kB, steady state %ld kB, %ld brains reused, %ld made\n",
+	 soak_ticks,soak_peak,(soak_samples ? soak_sum/soak_samples : 0),
+	 brainpool.Reused(),brainpool.Made());
+  double mean=soak_pop/soak_ticks;
+  double sd=soak_pop2/soak_ticks-mean*mean;
+  printf("[SOAK] %.0f ticks per second, %.1f +- %.1f organisms, %.2f born per 100 ticks\n",
+	 soak_ticks/(double(clock()-soak_start)/CLOCKS_PER_SEC),mean,
+	 (sd>0 ? sqrt(sd) : 0),100.0*(next_seq-soak_born)/soak_ticks);
+  printf("[SOAK] %.2f heap allocations per tick over the second half\n",
+	 double(ALLOCATIONS-soak_allocs)/(soak_ticks-SOAK_TICKS/2));
+  CountDense(orgstore,dense,gathered);
+  printf("[SOAK] %ld neurodes dense, %ld gathered\n",dense,gathered);
+  if(NEIGHBOR_SKIN>0)
+    printf("[SOAK] neighbor lists %ld rebuilt out of %ld used (skin %.2f)\n",
+	   list_builds,list_uses,NEIGHBOR_SKIN);
+  printf("[SOAK] vision repair %.1f swaps per tick, %ld at most\n",
+	 double(period_swaps)/soak_ticks,most_swaps);
+  printf("[SOAK] %.1f contact pairs per tick\n",double(period_pairs)/soak_ticks);
+  if(sensed)
+    printf("[SOAK] sensing %.2f us per organism\n",1e6*sense_time/CLOCKS_PER_SEC/sensed);
+  if(think_groups)
+    printf("[SOAK] thinking %.2f us per brain, %.1f brains of each shape\n",
+	   1e6*think_time/CLOCKS_PER_SEC/thought,double(thought)/think_groups);
+  if(period_reorders)
+    printf("[SOAK] %ld reorders, %.1f us each, next in the store %.2f apart before, %.2f after\n",
+	   period_reorders,1e6*reorder_time/CLOCKS_PER_SEC/period_reorders,
+	   gap_before/period_reorders,gap_after/period_reorders);
+  done=1;
+  return true;
+}
+
+// Times every kind of SpatialIndexClass on where the organisms and
+// food are right now, doing the same sort of queries that vision,
+// contact and eating do
+bool UniverseClass::Benchmark() {
+  vector<OrganismClass *> orgs,found;
+  SpatialIndexClass *oi,*fi;
+  double min_x=(-FLOOR_BLOCKS_X/2-1)*FLOOR_QUAD_SIZE;
+  double min_z=(-FLOOR_BLOCKS_Z/2-1)*FLOOR_QUAD_SIZE;
+  double max_x=(FLOOR_BLOCKS_X/2)*FLOOR_QUAD_SIZE;
+  double max_z=(FLOOR_BLOCKS_Z/2)*FLOOR_QUAD_SIZE;
+  double see=2*GRID_CELL_SIZE;
+  clock_t t0,t1,t2,t3,t4;
+  long hits;
+  int kind,i,rep;
+
+  for(i=0;i<orgstore->Size();i++)
+    orgs.push_back(orgstore->Get(i));
+  if(orgs.empty()) return false;
+
+  for(kind=0;kind<NUM_INDEXES;kind++) {
+    hits=0;
+    t0=clock();
+    oi=NewSpatialIndex(kind,min_x,min_z,max_x,max_z,GRID_CELL_SIZE);
+    fi=NewSpatialIndex(kind,min_x,min_z,max_x,max_z,GRID_CELL_SIZE);
+    for(i=0;i<(signed int)orgs.size();i++)
+      oi->Insert(orgs[i],i);
+    for(i=0;i<food->Size();i++)
+      fi->Insert(food->Get(i),i);
+    t1=clock();
+    for(rep=0;rep<BENCHMARK_REPEAT;rep++) {
+      for(i=0;i<(signed int)orgs.size();i++) {
+	found.clear();
+	hits+=oi->Query(orgs[i]->Pos(),see,see,found);
+	hits+=fi->Query(orgs[i]->Pos(),see,see,found);
+      }
+    }
+    t2=clock();
+    for(rep=0;rep<BENCHMARK_REPEAT;rep++) {
+      for(i=0;i<(signed int)orgs.size();i++)
+	oi->First(orgs[i]->Pos(),CONTACT_RANGE,CONTACT_RANGE,orgs[i],NULL);
+    }
+    t3=clock();
+    for(rep=0;rep<BENCHMARK_REPEAT;rep++) {
+      for(i=0;i<(signed int)orgs.size();i++)
+	fi->First(orgs[i]->Pos(),CONTACT_RANGE,CONTACT_RANGE,NULL,NULL);
+    }
+    t4=clock();
+
+    double per=1e6/CLOCKS_PER_SEC/(double(BENCHMARK_REPEAT)*orgs.size());
+    printf("[BENCH] %-6s build %.3f ms, vision %.3f us, contact %.3f us, eat %.3f us per organism (%d organisms, %d food, %.1f seen)\n",
+	   oi->Name(),1e3*(t1-t0)/CLOCKS_PER_SEC,(t2-t1)*per,(t3-t2)*per,
+	   (t4-t3)*per,(int)orgs.size(),food->Size(),
+	   double(hits)/(double(BENCHMARK_REPEAT)*orgs.size()));
+    delete oi;
+    delete fi;
+  }
   return true;
 }
 
@@ -682,6 +1444,7 @@ bool UniverseClass::Fight(OrganismClass *o1, OrganismClass *o2) {
   // Take that!
   if(!o2->Energy().TakeDamage(damage)) {
     o2->Type(ORGANISM_FOOD); // Uh oh, he died
+    Kill(o2);
 #if DEBUG_OUTPUT
     printf("Kill! (organism died and became food)\n");
 #endif
@@ -693,6 +1456,175 @@ bool UniverseClass::Fight(OrganismClass *o1, OrganismClass *o2) {
   return true;
 }
 
+// Times making BIRTH_BATCH newborns from random pairs of parents,
+// the way Mate() does, and counts the allocations they take.  The
+// first batch fills the pools, the second one is measured, and
+// both are deleted again without ever being in the world.
+bool UniverseClass::BirthBenchmark() {
+  vector<OrganismClass *> batch;
+  OrganismClass *a,*b;
+  long allocs=0;
+  clock_t t0,t1=0;
+  int i,rep;
+
+  if(orgstore->Size()<2) return false;
+  batch.reserve(BIRTH_BATCH);
+  for(rep=0;rep<2;rep++) {
+    allocs=ALLOCATIONS;
+    t0=clock();
+    for(i=0;i<BIRTH_BATCH;i++) {
+      a=orgstore->Get(rand()%orgstore->Size());
+      b=orgstore->Get(rand()%orgstore->Size());
+      IdToken token=idserver->GetToken();
+      AngleClass heading(0);
+      GeneClass genes(a->Genes(),b->Genes());
+      batch.push_back(new OrganismClass(token,a->Pos(),heading,genes));
+    }
+    t1=clock()-t0;
+    allocs=ALLOCATIONS-allocs;
+    for(i=0;i<(signed int)batch.size();i++)
+      delete batch[i];
+    batch.clear();
+  }
+  printf("[BENCH] births %.3f us, %.2f allocations each (%d spare brains)\n",
+	 1e6*t1/CLOCKS_PER_SEC/BIRTH_BATCH,double(allocs)/BIRTH_BATCH,
+	 brainpool.Size());
+  return true;
+}
+
+// Runs every live brain BENCHMARK_REPEAT times with each kind of
+// layer kernel the CPU can run, and checks its outputs against the
+// scalar one.  RunNet() only depends on the inputs and weights, and
+// everybody runs their brain again before anything reads the
+// outputs, so this leaves the world as it was.
+bool UniverseClass::BrainBenchmark() {
+  vector<float> ref,got;
+  double updates=0,worst;
+  clock_t t0,t1;
+  int kind,i,rep;
+
+  if(orgstore->IsEmpty()) return false;
+  for(i=0;i<orgstore->Size();i++) {
+    NeuralNet &nn=orgstore->Get(i)->Brain();
+    updates+=nn.NumNeurodes()+nn.NumOutputs();
+  }
+  for(kind=0;kind<NUM_NN_KERNELS;kind++) {
+    if(!NeuralNet::UseKernel(kind)) continue;
+    got.clear();
+    for(i=0;i<orgstore->Size();i++) {
+      orgstore->Get(i)->Brain().RunNet();
+      orgstore->Get(i)->Brain().GetOutputs(got);
+    }
+    if(kind==NN_KERNEL_SCALAR) ref=got;
+    worst=0;
+    for(i=0;i<(signed int)got.size();i++) {
+      double d=fabs(got[i]-ref[i])/(fabs(ref[i])>1 ? fabs(ref[i]) : 1);
+      if(d>worst) worst=d;
+    }
+    t0=clock();
+    for(rep=0;rep<BENCHMARK_REPEAT;rep++) {
+      for(i=0;i<orgstore->Size();i++)
+	orgstore->Get(i)->Brain().RunNet();
+    }
+    t1=clock()-t0;
+    printf("[BENCH] brains %-6s %.1f million neurode updates per second, %.2g off scalar at most%s\n",
+	   NeurodeKernelName(kind),
+	   (t1>0 ? updates*BENCHMARK_REPEAT/(1e6*t1/CLOCKS_PER_SEC) : 0),
+	   worst,(kind==NEURODE_KERNEL ? " (in use)" : ""));
+  }
+  NeuralNet::UseKernel(NEURODE_KERNEL);
+  LearnBenchmark();
+  return true;
+}
+
+// Times Learn() both ways on nets shaped like the live brains, and
+// thinking then learning in two passes against RunAndLearn().
+// Learning moves the weights, so the live brains are left alone.
+// The bytes are the weights, input indices and inputs read for each
+// neurode, with a layer learning right after it was worked out (so
+// from the cache) counted as free.
+bool UniverseClass::LearnBenchmark() {
+  vector<NeuralNet *> nets;
+  vector<OrganismClass *> orgs;
+  vector<float> lc,in;
+  double weights=0,out_weights=0,neurodes=0;
+  clock_t t[2],pass[2],batched;
+  int kind,i,j,rep,n,shapes=0;
+
+  // in the order Think() would take them
+  for(i=0;i<orgstore->Size();i++)
+    orgs.push_back(orgstore->Get(i));
+  sort(orgs.begin(),orgs.end(),ShapeBefore);
+  for(i=0;i<(signed int)orgs.size();i++) {
+    OrganismClass *o=orgs[i];
+    BrainInfoClass b=o->Genes().Brain();
+    NeuralNet *nn=new NeuralNet(b.NumNeurodes(),b.NumLayers(),
+				b.NumInputs(),b.NumOutputs(),b.TopoDist());
+    int per=nn->NumNeurodes()/nn->NumLayers();
+    in.resize(nn->NumInputs());
+    for(j=0;j<(signed int)in.size();j++)
+      in[j]=float(rand())/RAND_MAX*2.0-1.0;
+    nn->SetInputs(in);
+    nn->RunNet();
+    nets.push_back(nn);
+    lc.push_back(o->Genes().LC());
+    weights+=per*nn->NumInputs()+(nn->NumNeurodes()-per)*per;
+    out_weights+=nn->NumOutputs()*per;
+    neurodes+=nn->NumNeurodes()+nn->NumOutputs();
+  }
+  if(nets.empty()) return false;
+
+  for(kind=NN_LOGISTIC_EXACT;kind<=NN_LOGISTIC_FAST;kind++) {
+    NeuralNet::UseLogistic(kind);
+    t[kind]=clock();
+    for(rep=0;rep<BENCHMARK_REPEAT;rep++) {
+      for(i=0;i<(signed int)nets.size();i++)
+	nets[i]->Learn(lc[i],ALPHA_COEFFICIENT);
+    }
+    t[kind]=clock()-t[kind];
+  }
+  NeuralNet::UseLogistic(LOGISTIC);
+  printf("[BENCH] learning exact %.1f, fast %.1f million weights per second\n",
+	 (t[0]>0 ? weights*BENCHMARK_REPEAT/(1e6*t[0]/CLOCKS_PER_SEC) : 0),
+	 (t[1]>0 ? weights*BENCHMARK_REPEAT/(1e6*t[1]/CLOCKS_PER_SEC) : 0));
+
+  for(kind=0;kind<2;kind++) {
+    pass[kind]=clock();
+    for(rep=0;rep<BENCHMARK_REPEAT;rep++) {
+      for(i=0;i<(signed int)nets.size();i++) {
+	if(kind) {
+	  nets[i]->RunAndLearn(lc[i],ALPHA_COEFFICIENT);
+	} else {
+	  nets[i]->RunNet();
+	  nets[i]->Learn(lc[i],ALPHA_COEFFICIENT);
+	}
+      }
+    }
+    pass[kind]=clock()-pass[kind];
+  }
+  double per_neurode=1e9/CLOCKS_PER_SEC/(neurodes*BENCHMARK_REPEAT);
+  double bytes=3*sizeof(float)*(weights+out_weights)/neurodes;
+  printf("[BENCH] think and learn in two passes %.1f ns and %.0f bytes, fused %.1f ns and %.0f bytes per neurode\n",
+	 pass[0]*per_neurode,bytes+3*sizeof(float)*weights/neurodes,
+	 pass[1]*per_neurode,bytes);
+
+  n=nets.size();
+  batched=clock();
+  for(rep=0;rep<BENCHMARK_REPEAT;rep++) {
+    for(i=0;i<n;i=j) {
+      for(j=i+1;j<n && SameShape(*nets[i],*nets[j]);j++) ;
+      NeuralNet::RunBatch(&nets[i],j-i,&lc[i],ALPHA_COEFFICIENT,1);
+      if(!rep) shapes++;
+    }
+  }
+  batched=clock()-batched;
+  printf("[BENCH] fused one brain at a time %.1f ns, batched by shape %.1f ns per neurode (%.1f brains of each shape)\n",
+	 pass[1]*per_neurode,batched*per_neurode,double(n)/shapes);
+  for(i=0;i<(signed int)nets.size();i++)
+    delete nets[i];
+  return true;
+}
+
 bool UniverseClass::Mate(OrganismClass *o1, OrganismClass *o2) {
   if(o1==o2) return false; // no asexuals allowed
 
@@ -729,16 +1661,16 @@ bool UniverseClass::Mate(OrganismClass *o1, OrganismClass *o2) {
   matestack.push(es);
 
   // create an kiddie
-  IdToken *token=idserver->GetToken();
-  VectorClass *position=new VectorClass(double(rand())/RAND_MAX*2.0-1.0+o1->Pos().X(),0,o2->Pos().Z()+double(rand())/RAND_MAX*2.0-1.0);
-  AngleClass *heading=new AngleClass(0);
+  IdToken token=idserver->GetToken();
+  VectorClass position(double(rand())/RAND_MAX*2.0-1.0+o1->Pos().X(),0,o2->Pos().Z()+double(rand())/RAND_MAX*2.0-1.0);
+  AngleClass heading(0);
   // with the parent's genes used
-  GeneClass *genes=new GeneClass(o1->Genes(),o2->Genes());
+  GeneClass genes(o1->Genes(),o2->Genes());
   OrganismClass *o3 = new OrganismClass(token,
 					position,
 					heading,
 					genes);
-  orglist->Append(o3);
+  Add(o3);
 
   // Give the new guy energy that mommy and daddy spent
   o3->Energy().EatFood(o1_spend + o2_spend);
@@ -747,9 +1679,9 @@ bool UniverseClass::Mate(OrganismClass *o1, OrganismClass *o2) {
 }
 
 bool UniverseClass::UpdateDraw() {
-  orglist->Rewind();
-  OrganismClass *o;
-  
+  int i;
+
+  if(!ogl) return false;
   PrepareDraw();
 
   DrawLandscape();
@@ -758,9 +1690,10 @@ bool UniverseClass::UpdateDraw() {
   ogl->DrawStack(matestack);
   ogl->DrawStack(foodstack);
 
-  while((o=orglist->Next())) {
-    DrawOrganism(o);
-  }
+  for(i=0;i<orgstore->Size();i++)
+    DrawOrganism(orgstore->Get(i));
+  for(i=0;i<food->Size();i++)
+    DrawOrganism(food->Get(i));
 
 
   Draw();
@@ -790,6 +1723,7 @@ bool UniverseClass::Draw() {
 }
 
 bool UniverseClass::CheckKeys() {
+  if(!ogl) return false;
   double xpos=world->Pos().X();
   double ypos=world->Pos().Y();
   double zpos=world->Pos().Z();
@@ -22,16 +22,22 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #define UNIVERSE_H_87634
 #include<vector>
 #include<stack>
+#include<time.h>
 using namespace std;
 #include"vector.h"
 #include"color.h"
+#include"quicksort.h"
+#include"spatial.h"
 
 
 class WorldClass;
 class OpenGLClass;
-class OrganismListClass;
+class OrganismStoreClass;
 class IdServerClass;
 class OrganismClass;
+class SpatialIndexClass;
+class FoodStoreClass;
+class NeuralNet;
 
 struct EventStack {
   VectorClass a,b;
@@ -39,21 +45,110 @@ struct EventStack {
   int frames_remaining;  // How many frames this flash should be visible
 };
 
+// a can reach b.  The seqs are the order they came into the world in.
+struct ContactPair {
+  OrganismClass *a,*b;
+  long a_seq,b_seq;
+};
+
 class UniverseClass {
 private:
   WorldClass *world;
-  OpenGLClass *ogl;
-  OrganismListClass *orglist;
+  OpenGLClass *ogl;  // NULL with -m, which draws nothing
+  OrganismStoreClass *orgstore;
   IdServerClass *idserver;
+  SpatialIndexClass *index;
+  long next_seq;
+  FoodStoreClass *food;
+  // Every organism belongs to exactly one of orgstore (alive), food
+  // or graveyard (taken out of the world this tick, deleted by
+  // Bury() at the start of the next one).  Moving one from one to
+  // another goes through Add(), Kill() or Discard().
+  vector<OrganismClass *> graveyard;
+  // drift is how far anything could have moved since the start,
+  // tick_step how far the farthest mover went this tick
+  double drift,tick_step;
+  long list_builds,list_uses;
+  // one row of inputs per live organism, filled in by Sense()
+  vector<float> senses;
+  int senses_width;
+  // reused by Sense() from one organism to the next
+  vector<OList> sight,foodsight,repair;
+  // how many swaps RepairOList() has done
+  long tick_swaps,period_swaps,most_swaps;
+  // who can reach whom this tick, see FindContacts()
+  vector<ContactPair> contacts;
+  vector<IndexEntry> contact_cand;
+  long tick_pairs,period_pairs;
+  vector<OrganismClass *> nearby;
+  // The rest of what a tick needs for itself, kept from one tick to
+  // the next so that once they are big enough nothing is allocated:
+  // whose turn it is and who died of age (see Update()), the
+  // outputs of whoever acts and of whom they met, and what Add(),
+  // FindContacts() and SeeAll() gather up
+  vector<OrganismClass *> turns,aged;
+  vector<float> outputs,mate_outputs;
+  vector<OrganismClass *> added_near,everything;
+  vector<IndexEntry> everyone;
+  vector<OList> check_sight;
+  // packed positions and results for SightKernel()
+  vector<double> cand_x,cand_z,cand_dist2;
+  vector<unsigned char> cand_front;
+  // what -m has seen so far: memory in kB, and how the population
+  // went, to compare one build against another
+  long soak_ticks,soak_peak,soak_sum,soak_samples,soak_born,soak_allocs;
+  double soak_pop,soak_pop2;
+  clock_t soak_start;
+  // Reorder() puts the store in Morton order every REORDER_TICKS
+  // ticks.  Its cost, and how far apart organisms that follow each
+  // other in the store are before and after, are kept for the stats,
+  // along with how long sensing takes, which is what it is for.
+  long ticks,reorders,period_reorders;
+  clock_t reorder_time,sense_time;
+  double gap_before,gap_after;
+  long sensed;
+  vector<unsigned int> reorder_keys;
+  vector<int> sense_order;
+  // Think() sorts everyone by the shape of their brain, and keeps
+  // count of how long it takes and how many shapes it found
+  vector<OrganismClass *> thinkers;
+  vector<NeuralNet *> think_nets;
+  vector<float> think_lc;
+  clock_t think_time;
+  long thought,think_groups;
   int done,pause;
-  stack<EventStack> fightstack,matestack,foodstack;
+  // on vectors, which keep their room from tick to tick
+  stack<EventStack,vector<EventStack> > fightstack,matestack,foodstack;
 public:
   UniverseClass(int,char **);
   ~UniverseClass();
   bool MainLoop();
   bool Update();
   bool UpdateDraw();
-  bool UpdateOrganism(OrganismClass *,vector<OrganismClass *>,int);
+  bool Reorder();
+  bool Sense(vector<OrganismClass *> &);
+  bool Sense(OrganismClass *,float *);
+  bool Think(vector<OrganismClass *> &);
+  bool UpdateOrganism(OrganismClass *,float *);
+  bool Look(OrganismClass *,VectorClass &,int,bool,vector<OList> &);
+  bool See(OrganismClass *,VectorClass &,int,bool,vector<OList> &);
+  bool SeeAll(OrganismClass *,VectorClass &,bool,vector<OList> &);
+  bool Sight(OrganismClass *,VectorClass &,vector<OrganismClass *> &,double,vector<OList> &);
+  OrganismClass *Contact(OrganismClass *);
+  int FindContacts(vector<OrganismClass *> &);
+  bool Interact(vector<OrganismClass *> &);
+  bool Meet(OrganismClass *,OrganismClass *,int);
+  double Neighbors(OrganismClass *);
+  OrganismClass *NearFirst(OrganismClass *,double,double);
+  bool Add(OrganismClass *);
+  bool Kill(OrganismClass *);
+  bool Discard(OrganismClass *);
+  bool Bury();
+  bool Benchmark();
+  bool BirthBenchmark();
+  bool BrainBenchmark();
+  bool LearnBenchmark();
+  bool Soak();
   bool DrawOrganism(OrganismClass *);
   bool PrepareDraw();
   bool DrawLandscape();
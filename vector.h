@@ -21,9 +21,11 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #ifndef VECTOR_H_46768
 #define VECTOR_H_46768
 
+#include"real.h"
+
 class VectorClass {
 private:
-  double x,y,z;
+  real x,y,z;
 public:
   VectorClass();
   VectorClass(double,double,double);
@@ -0,0 +1,230 @@
+/* 
+
+Copyright (C) 2000 Matthew Danish
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+#include<stdlib.h>
+#include<vector>
+using namespace std;
+#include"vitals.h"
+#include"org.h"
+#include"defines.h"
+
+/*
+ * vitals.cc
+ *
+ * Rows are never moved, so a row number stays good for as long as
+ * its organism is around.  Free rows are chained through next_free
+ * and have the type ORGANISM_GONE, so passes over every row can
+ * skip them the same way they skip the dead.
+ */
+
+VitalsClass::VitalsClass() :
+  free_row(-1),
+  used(0)
+{}
+
+VitalsClass::~VitalsClass() {}
+
+// p and h come by value, since they may be another organism's row,
+// which a new row can move
+int VitalsClass::Alloc(OrganismClass *o,VectorClass p,AngleClass h) {
+  int r;
+  if(free_row>=0) {
+    r=free_row;
+    free_row=next_free[r];
+  } else {
+    r=owner.size();
+    pos.push_back(p);
+    heading.push_back(h);
+    color.push_back(ColorClass());
+    food.push_back(0);
+    health.push_back(0);
+    fcap.push_back(0);
+    hcap.push_back(0);
+    metabolism.push_back(0);
+    lifespan.push_back(0);
+    type.push_back(ORGANISM_GONE);
+    owner.push_back(NULL);
+    next_free.push_back(-1);
+  }
+  pos[r]=p;
+  heading[r]=h;
+  color[r]=ColorClass();
+  food[r]=health[r]=fcap[r]=hcap[r]=metabolism[r]=0;
+  lifespan[r]=0;
+  type[r]=ORGANISM_GONE;
+  owner[r]=o;
+  used++;
+  return r;
+}
+
+bool VitalsClass::Free(int r) {
+  if(r<0 || r>=(signed int)owner.size() || !owner[r]) return false;
+  type[r]=ORGANISM_GONE;
+  owner[r]=NULL;
+  next_free[r]=free_row;
+  free_row=r;
+  used--;
+  return true;
+}
+
+// How many rows there are, in use or not
+int VitalsClass::Size() {
+  return owner.size();
+}
+
+// How many rows belong to an organism
+int VitalsClass::Used() {
+  return used;
+}
+
+OrganismClass *VitalsClass::Owner(int r) {
+  return owner[r];
+}
+
+VectorClass & VitalsClass::Pos(int r) {
+  return pos[r];
+}
+
+AngleClass & VitalsClass::Heading(int r) {
+  return heading[r];
+}
+
+ColorClass & VitalsClass::Color(int r) {
+  return color[r];
+}
+
+double VitalsClass::Food(int r) {
+  return food[r];
+}
+
+double VitalsClass::Health(int r) {
+  return health[r];
+}
+
+double VitalsClass::FoodCap(int r) {
+  return fcap[r];
+}
+
+double VitalsClass::HealthCap(int r) {
+  return hcap[r];
+}
+
+// No food, and health full up to cap, which is also both caps
+bool VitalsClass::Reset(int r,double cap) {
+  food[r]=0;
+  health[r]=fcap[r]=hcap[r]=cap;
+  return true;
+}
+
+bool VitalsClass::SetCap(int r,double cap) {
+  hcap[r]=fcap[r]=cap;
+  if(health[r] > hcap[r]) health[r] = hcap[r];
+  if(food[r] > fcap[r]) food[r] = fcap[r];
+  return true;
+}
+
+double VitalsClass::Metabolism(int r,double m) {
+  return (metabolism[r]=m);
+}
+
+long VitalsClass::Lifespan(int r) {
+  return lifespan[r];
+}
+
+long VitalsClass::Lifespan(int r,long l) {
+  return (lifespan[r]=l);
+}
+
+short VitalsClass::Type(int r) {
+  return type[r];
+}
+
+short VitalsClass::Type(int r,short t) {
+  return (type[r]=t);
+}
+
+bool VitalsClass::TakeDamage(int r,double dmg) {
+  health[r]-=dmg;
+  if(health[r]<=0) {
+    health[r] = 0;
+    return false;  // dead!
+  } else
+    return true;
+}
+
+bool VitalsClass::UseEnergy(int r,double amt) {
+  if(food[r]-amt < 0)
+    return false;  // no can do..
+  else {
+    food[r]-=amt;
+    return true;
+  }
+}
+
+double VitalsClass::Regen(int r,double meta) {
+  double amt = (hcap[r]-health[r])/hcap[r] * (fcap[r]-food[r])/fcap[r] * food[r] * meta;
+  food[r]-=amt;
+  health[r]+=amt;
+  if(health[r]>hcap[r]) health[r]=hcap[r];
+  if(food[r]<0) food[r]=0;
+  return amt;
+}
+
+bool VitalsClass::EatFood(int r,double f) {
+  food[r]+=f;
+  return true;
+}
+
+// One tick of life for row r, see OrganismClass::Lifetick()
+bool VitalsClass::Lifetick(int r) {
+  if(type[r]==ORGANISM_LIVE) {
+    // Regenerate some health
+    Regen(r,metabolism[r]);
+
+    if(!--lifespan[r]) {
+      owner[r]->Type(ORGANISM_FOOD);
+      TakeDamage(r,health[r]);
+      return false;
+    }
+    if(TakeDamage(r,metabolism[r] * ENERGY_LOSS_PER_TICK * hcap[r])==false) {
+      owner[r]->Type(ORGANISM_FOOD);
+      return false;
+    }
+  } else {
+    // Food decay: lifespan counts down each tick
+    if(--lifespan[r]<=0) {
+      // Food has fully decayed
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Runs Lifetick() on every live organism in one pass over the rows,
+// and puts the ones that died of it on dead
+int VitalsClass::Lifetick(vector<OrganismClass *> &dead) {
+  int r,n=owner.size();
+  for(r=0;r<n;r++) {
+    if(type[r]==ORGANISM_LIVE && !Lifetick(r))
+      dead.push_back(owner[r]);
+  }
+  return dead.size();
+}
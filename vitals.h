@@ -0,0 +1,81 @@
+/* 
+
+Copyright (C) 2000 Matthew Danish
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+#ifndef VITALS_H_52817
+#define VITALS_H_52817
+#include<vector>
+using namespace std;
+#include"real.h"
+#include"vector.h"
+#include"angle.h"
+#include"color.h"
+
+class OrganismClass;
+
+// The part of every organism that changes every tick, one row per
+// organism, with each field kept in an array of its own so a pass
+// over all of them streams through memory.  OrganismClass and
+// EnergyClass only remember their row and read and write it here.
+// A row belongs to its organism from construction until it is
+// deleted, then it is handed out again.  Pos(), Heading() and
+// Color() hand back references into their arrays, which are good
+// until the next Alloc() that has to add a row.
+class VitalsClass {
+private:
+  vector<VectorClass> pos;
+  vector<AngleClass> heading;
+  vector<ColorClass> color;
+  vector<real> food,health,fcap,hcap,metabolism;
+  vector<long> lifespan;
+  vector<short> type;
+  vector<OrganismClass *> owner;
+  vector<int> next_free;
+  int free_row,used;
+public:
+  VitalsClass();
+  ~VitalsClass();
+  int Alloc(OrganismClass *,VectorClass,AngleClass);
+  bool Free(int);
+  int Size();
+  int Used();
+  OrganismClass *Owner(int);
+  VectorClass & Pos(int);
+  AngleClass & Heading(int);
+  ColorClass & Color(int);
+  double Food(int);
+  double Health(int);
+  double FoodCap(int);
+  double HealthCap(int);
+  bool Reset(int,double);
+  bool SetCap(int,double);
+  double Metabolism(int,double);
+  long Lifespan(int);
+  long Lifespan(int,long);
+  short Type(int);
+  short Type(int,short);
+  bool TakeDamage(int,double);
+  bool UseEnergy(int,double);
+  double Regen(int,double);
+  bool EatFood(int,double);
+  bool Lifetick(int);
+  int Lifetick(vector<OrganismClass *> &);
+};
+
+#endif
@@ -50,9 +50,7 @@ AngleClass &WorldClass::Heading() {
   return heading;
 }
 
-VectorClass * WorldClass::NewPosition() {
-  VectorClass *v;
-
+VectorClass WorldClass::NewPosition() {
   // Ensure minimum spawn area even for 1x1 world (use FLOOR_QUAD_SIZE as minimum)
   double spawn_width = Size().X() > 0 ? Size().X() : FLOOR_QUAD_SIZE;
   double spawn_depth = Size().Z() > 0 ? Size().Z() : FLOOR_QUAD_SIZE;
@@ -62,9 +60,7 @@ VectorClass * WorldClass::NewPosition() {
   double x_pos = (double(rand()) / RAND_MAX) * spawn_width - spawn_width/2.0;
   double z_pos = (double(rand()) / RAND_MAX) * spawn_depth - spawn_depth/2.0;
   
-  v = new VectorClass(x_pos, 0, z_pos);
-  
-  return v;
+  return VectorClass(x_pos, 0, z_pos);
 }
 
 bool WorldClass::ChangePosition(VectorClass &p, VectorClass &d) {
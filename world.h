@@ -36,7 +36,7 @@ public:
   VectorClass &Pos();
   AngleClass &Heading();
   bool ChangePosition(VectorClass &,VectorClass &);
-  VectorClass *NewPosition();
+  VectorClass NewPosition();
 };
 
 